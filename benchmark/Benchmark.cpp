@@ -9,12 +9,17 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <string_view>
 #include <thread>
 
 #include <benchmark/Benchmark.h>
+#include <benchmark/PerfCounters.h>
 #include <benchmark/TreeDeserialization.h>
 #include <capture/CaptureTree.h>
 #include <nlohmann/json.hpp>
+#include <yoga/debug/AllocationCounter.h>
+#include <yoga/event/LayoutTelemetryRecorder.h>
+#include <yoga/event/event.h>
 
 namespace facebook::yoga {
 
@@ -308,7 +313,9 @@ std::shared_ptr<YogaNodeAndConfig> buildTreeFromJson(
   return wrapper;
 }
 
-BenchmarkResult generateBenchmark(json& capture) {
+BenchmarkResult generateBenchmark(
+    json& capture,
+    PerfCounters* counters = nullptr) {
   auto fns = std::make_shared<SerializedMeasureFuncMap>();
 
   auto treeCreationBegin = steady_clock::now();
@@ -321,10 +328,16 @@ BenchmarkResult generateBenchmark(json& capture) {
   float availableHeight = layoutInputs["available-height"];
   YGDirection direction = directionFromString(layoutInputs["owner-direction"]);
 
+  if (counters != nullptr) {
+    counters->start();
+  }
   auto layoutBegin = steady_clock::now();
   YGNodeCalculateLayout(
       root->node_.get(), availableWidth, availableHeight, direction);
   auto layoutEnd = steady_clock::now();
+  if (counters != nullptr) {
+    counters->stop();
+  }
 
   return BenchmarkResult{
       treeCreationEnd - treeCreationBegin, layoutEnd - layoutBegin};
@@ -355,7 +368,108 @@ static void printBenchmarkResult(
   printf("%s: median: %lf ms, stddev: %lf ms\n", name.c_str(), median, stddev);
 }
 
-void benchmark(std::filesystem::path& capturesDir) {
+// Times layout of the capture while a subscriber counts events of the given
+// types
+static void benchmarkLayoutWithSubscriber(
+    const std::string& name,
+    json& capture,
+    Event::TypeMask types) {
+  SteadyClockDurations layoutDurations;
+  uint64_t eventCount = 0;
+  Event::subscribe(
+      [&](YGNodeConstRef, Event::Type, Event::Data) { eventCount++; }, types);
+  for (uint32_t i = 0; i < kNumRepetitions; i++) {
+    layoutDurations[i] = generateBenchmark(capture).layoutDuration;
+  }
+  Event::reset();
+
+  printBenchmarkResult(name, layoutDurations);
+  printf(
+      "%s: %lf events per run\n",
+      name.c_str(),
+      static_cast<double>(eventCount) / kNumRepetitions);
+}
+
+// Times layout of the capture while the telemetry recorder is enabled
+static void benchmarkLayoutWithTelemetry(
+    const std::string& name,
+    json& capture) {
+  SteadyClockDurations layoutDurations;
+  {
+    LayoutTelemetryRecorder recorder;
+    for (uint32_t i = 0; i < kNumRepetitions; i++) {
+      layoutDurations[i] = generateBenchmark(capture).layoutDuration;
+    }
+  }
+  Event::reset();
+
+  printBenchmarkResult(name, layoutDurations);
+}
+
+// Counts the heap allocations made by layout of the capture, in builds which
+// count them
+static void benchmarkLayoutAllocations(const std::string& name, json& capture) {
+  uint64_t allocations = 0;
+  uint64_t allocatedBytes = 0;
+  Event::subscribe(
+      [&](YGNodeConstRef, Event::Type, Event::Data data) {
+        const auto& layoutData = *data.get<Event::LayoutPassEnd>().layoutData;
+        allocations += layoutData.allocations;
+        allocatedBytes += layoutData.allocatedBytes;
+      },
+      Event::typeMask<Event::LayoutPassEnd>());
+  for (uint32_t i = 0; i < kNumRepetitions; i++) {
+    generateBenchmark(capture);
+  }
+  Event::reset();
+
+  printf(
+      "%s: %lf allocations, %lf bytes per run\n",
+      name.c_str(),
+      static_cast<double>(allocations) / kNumRepetitions,
+      static_cast<double>(allocatedBytes) / kNumRepetitions);
+}
+
+// Counts hardware and software events of layout of the capture, to tell
+// whether it is bound by memory or by computation
+static void benchmarkLayoutWithPerfCounters(
+    const std::string& name,
+    json& capture) {
+  PerfCounters counters;
+  if (!counters.available()) {
+    printf("%s: no performance counters available\n", name.c_str());
+    return;
+  }
+  for (uint32_t i = 0; i < kNumRepetitions; i++) {
+    generateBenchmark(capture, &counters);
+  }
+
+  const auto values = counters.read();
+  for (size_t i = 0; i < values.size(); i++) {
+    const char* counterName = perfCounterName(static_cast<PerfCounter>(i));
+    if (values[i]) {
+      printf(
+          "%s: %s: %lf per run\n",
+          name.c_str(),
+          counterName,
+          static_cast<double>(*values[i]) / kNumRepetitions);
+    } else {
+      printf("%s: %s: not available\n", name.c_str(), counterName);
+    }
+  }
+
+  const auto& cycles = values[static_cast<size_t>(PerfCounter::Cycles)];
+  const auto& instructions =
+      values[static_cast<size_t>(PerfCounter::Instructions)];
+  if (cycles && instructions && *cycles > 0) {
+    printf(
+        "%s: instructions per cycle: %lf\n",
+        name.c_str(),
+        static_cast<double>(*instructions) / static_cast<double>(*cycles));
+  }
+}
+
+void benchmark(std::filesystem::path& capturesDir, bool perfCounters) {
   for (auto& capture : std::filesystem::directory_iterator(capturesDir)) {
     if (capture.is_directory() || capture.path().extension() != ".json") {
       continue;
@@ -381,6 +495,28 @@ void benchmark(std::filesystem::path& capturesDir) {
     printBenchmarkResult(captureName + " layout", layoutDurations);
     printBenchmarkResult(captureName + " total", totalDurations);
 
+    // Publishing events costs nothing more than a check until something
+    // subscribes, so compare against layout with subscribers which do as
+    // little as possible
+    if (Event::enabled) {
+      benchmarkLayoutWithSubscriber(
+          captureName + " layout with event subscriber", j, Event::allTypes);
+      benchmarkLayoutWithSubscriber(
+          captureName + " layout with allocation subscriber",
+          j,
+          Event::typeMask<Event::NodeAllocation, Event::NodeDeallocation>());
+      benchmarkLayoutWithTelemetry(
+          captureName + " layout with telemetry recorder", j);
+    }
+
+    if (Event::enabled && kCountAllocations) {
+      benchmarkLayoutAllocations(captureName + " layout", j);
+    }
+
+    if (perfCounters) {
+      benchmarkLayoutWithPerfCounters(captureName + " layout", j);
+    }
+
     std::cout << std::endl;
   }
 }
@@ -388,11 +524,16 @@ void benchmark(std::filesystem::path& capturesDir) {
 } // namespace facebook::yoga
 
 int main(int argc, char* argv[]) {
-  if (argc == 2) {
+  const bool perfCounters =
+      argc == 3 && std::string_view{argv[1]} == "--perf-counters";
+  if (argc == 2 || perfCounters) {
     std::filesystem::path capturesDir = argv[argc - 1];
-    facebook::yoga::benchmark(capturesDir);
+    facebook::yoga::benchmark(capturesDir, perfCounters);
+    facebook::yoga::styleChurnBenchmark();
+    facebook::yoga::edgeResolutionBenchmark();
   } else {
-    throw std::invalid_argument("Expecting a path as an argument");
+    throw std::invalid_argument(
+        "Expecting [--perf-counters] and a path as arguments");
     return 1;
   }
 
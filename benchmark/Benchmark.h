@@ -36,4 +36,7 @@ struct BenchmarkResult {
   std::chrono::steady_clock::duration layoutDuration;
 };
 
+void styleChurnBenchmark();
+void edgeResolutionBenchmark();
+
 } // namespace facebook::yoga
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+
+#include <benchmark/Benchmark.h>
+#include <yoga/style/Style.h>
+
+namespace facebook::yoga {
+
+using namespace std::chrono;
+
+constexpr uint32_t kNumEdgeResolutionRounds = 200000;
+
+// Sets every edge family of the style through the given edge, so reading a
+// physical edge has to fall back to it
+static Style styleWithEdges(Edge edge) {
+  Style style;
+  style.setMargin(edge, StyleLength::points(4.0f));
+  style.setPosition(edge, StyleLength::percent(10.0f));
+  style.setPadding(edge, StyleLength::points(8.0f));
+  style.setBorder(edge, StyleLength::points(1.0f));
+  return style;
+}
+
+// Reads the physical edges of styles whose edges are set through each kind of
+// edge, as layout does for every node on every pass. Reports the cost of
+// resolving a single edge.
+void edgeResolutionBenchmark() {
+  std::printf("Starting benchmark for edge resolution\n");
+  const std::array<Style, 6> styles = {
+      styleWithEdges(Edge::Left),
+      styleWithEdges(Edge::Top),
+      styleWithEdges(Edge::Start),
+      styleWithEdges(Edge::Horizontal),
+      styleWithEdges(Edge::Vertical),
+      styleWithEdges(Edge::All),
+  };
+  constexpr std::array<FlexDirection, 2> axes = {
+      FlexDirection::Row, FlexDirection::Column};
+  constexpr std::array<Direction, 2> directions = {
+      Direction::LTR, Direction::RTL};
+
+  float sum = 0.0f;
+  uint64_t resolutions = 0;
+  auto begin = steady_clock::now();
+  for (uint32_t round = 0; round < kNumEdgeResolutionRounds; round++) {
+    for (const auto& style : styles) {
+      for (const auto axis : axes) {
+        for (const auto direction : directions) {
+          sum += style.computeInlineStartMargin(axis, direction, 100.0f) +
+              style.computeInlineEndMargin(axis, direction, 100.0f) +
+              style.computeInlineStartPosition(axis, direction, 100.0f) +
+              style.computeInlineEndPosition(axis, direction, 100.0f) +
+              style.computeFlexStartPaddingAndBorder(axis, direction, 100.0f) +
+              style.computeFlexEndPaddingAndBorder(axis, direction, 100.0f);
+          resolutions += 8;
+        }
+      }
+    }
+  }
+  auto end = steady_clock::now();
+
+  std::printf(
+      "edge resolution: %lf ns per edge (checksum %f)\n",
+      duration<double, std::nano>(end - begin).count() /
+          static_cast<double>(resolutions),
+      static_cast<double>(sum));
+  std::printf("\n");
+}
+
+} // namespace facebook::yoga
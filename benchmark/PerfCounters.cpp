@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+
+#include <benchmark/PerfCounters.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::yoga {
+
+const char* perfCounterName(PerfCounter counter) {
+  switch (counter) {
+    case PerfCounter::Cycles:
+      return "cycles";
+    case PerfCounter::Instructions:
+      return "instructions";
+    case PerfCounter::BranchMisses:
+      return "branch misses";
+    case PerfCounter::L1DataCacheMisses:
+      return "L1d misses";
+    case PerfCounter::LastLevelCacheMisses:
+      return "LLC misses";
+    case PerfCounter::PageFaults:
+      return "page faults";
+    case PerfCounter::COUNT:
+      break;
+  }
+  return "unknown";
+}
+
+#ifdef __linux__
+
+static constexpr uint64_t cacheReadMisses(uint64_t cache) {
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+static int openCounter(PerfCounter counter, int groupFd) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // Counters on their own read as a group of one
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+      PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  switch (counter) {
+    case PerfCounter::Cycles:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case PerfCounter::Instructions:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case PerfCounter::BranchMisses:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+      break;
+    case PerfCounter::L1DataCacheMisses:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = cacheReadMisses(PERF_COUNT_HW_CACHE_L1D);
+      break;
+    case PerfCounter::LastLevelCacheMisses:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = cacheReadMisses(PERF_COUNT_HW_CACHE_LL);
+      break;
+    case PerfCounter::PageFaults:
+      attr.type = PERF_TYPE_SOFTWARE;
+      attr.config = PERF_COUNT_SW_PAGE_FAULTS;
+      break;
+    case PerfCounter::COUNT:
+      return -1;
+  }
+
+  // The calling thread, on any CPU
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, &attr, 0 /*pid*/, -1 /*cpu*/, groupFd, 0));
+}
+
+PerfCounters::PerfCounters() {
+  fds_.fill(-1);
+  groupFds_.fill(-1);
+  groupIndices_.fill(0);
+
+  // The first counter which opens leads the group. The kernel refuses
+  // members which would make the group impossible to schedule at once.
+  int leaderFd = -1;
+  size_t groupSize = 0;
+  for (size_t i = 0; i < kCount; i++) {
+    const auto counter = static_cast<PerfCounter>(i);
+    if (leaderFd >= 0) {
+      fds_[i] = openCounter(counter, leaderFd);
+      if (fds_[i] >= 0) {
+        groupFds_[i] = leaderFd;
+        groupIndices_[i] = groupSize++;
+        continue;
+      }
+    }
+
+    fds_[i] = openCounter(counter, -1);
+    if (fds_[i] >= 0) {
+      groupFds_[i] = fds_[i];
+      if (leaderFd < 0) {
+        leaderFd = fds_[i];
+        groupSize = 1;
+      }
+    }
+  }
+}
+
+PerfCounters::~PerfCounters() {
+  for (int fd : fds_) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+}
+
+// Counters read through their own descriptor lead a group, possibly of one
+void PerfCounters::start() {
+  for (size_t i = 0; i < kCount; i++) {
+    if (fds_[i] >= 0 && groupFds_[i] == fds_[i]) {
+      ioctl(fds_[i], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+  }
+}
+
+void PerfCounters::stop() {
+  for (size_t i = 0; i < kCount; i++) {
+    if (fds_[i] >= 0 && groupFds_[i] == fds_[i]) {
+      ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+  }
+}
+
+PerfCounterValues PerfCounters::read() const {
+  PerfCounterValues values;
+  for (size_t i = 0; i < kCount; i++) {
+    if (fds_[i] < 0 || groupFds_[i] != fds_[i]) {
+      continue;
+    }
+
+    // The number of counts, the times the group was enabled and running,
+    // then the counts in the order the counters joined the group
+    std::array<uint64_t, 3 + kCount> data{};
+    const auto size = ::read(fds_[i], data.data(), sizeof(data));
+    if (size < static_cast<ssize_t>(3 * sizeof(uint64_t)) ||
+        static_cast<size_t>(size) < (3 + data[0]) * sizeof(uint64_t)) {
+      continue;
+    }
+    const uint64_t enabled = data[1];
+    const uint64_t running = data[2];
+
+    for (size_t j = 0; j < kCount; j++) {
+      if (groupFds_[j] != fds_[i] || groupIndices_[j] >= data[0]) {
+        continue;
+      }
+      const uint64_t count = data[3 + groupIndices_[j]];
+      if (running == 0) {
+        values[j] = enabled == 0 ? std::optional<uint64_t>{0} : std::nullopt;
+      } else if (running < enabled) {
+        values[j] = static_cast<uint64_t>(
+            static_cast<double>(count) * static_cast<double>(enabled) /
+            static_cast<double>(running));
+      } else {
+        values[j] = count;
+      }
+    }
+  }
+  return values;
+}
+
+#else
+
+PerfCounters::PerfCounters() {
+  fds_.fill(-1);
+  groupFds_.fill(-1);
+  groupIndices_.fill(0);
+}
+
+PerfCounters::~PerfCounters() = default;
+
+void PerfCounters::start() {}
+
+void PerfCounters::stop() {}
+
+PerfCounterValues PerfCounters::read() const {
+  return {};
+}
+
+#endif
+
+bool PerfCounters::available() const {
+  return std::any_of(fds_.begin(), fds_.end(), [](int fd) { return fd >= 0; });
+}
+
+} // namespace facebook::yoga
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+namespace facebook::yoga {
+
+enum class PerfCounter : uint8_t {
+  Cycles,
+  Instructions,
+  BranchMisses,
+  L1DataCacheMisses,
+  LastLevelCacheMisses,
+  PageFaults,
+  COUNT
+};
+
+const char* perfCounterName(PerfCounter counter);
+
+// Counts, with nothing counted for the counters which could not be opened
+using PerfCounterValues = std::array<
+    std::optional<uint64_t>,
+    static_cast<size_t>(PerfCounter::COUNT)>;
+
+// Hardware and software performance counters of the calling thread, read
+// through perf_event_open on Linux. Counting only happens between start()
+// and stop(), and accumulates until the counters are destroyed.
+//
+// Counters are opened as a single group, so that they count over the same
+// intervals and their ratios stay meaningful. Counters the group cannot take
+// count on their own.
+//
+// Counters can be missing: on other platforms, in virtual machines without a
+// PMU, or when perf_event_paranoid forbids them. Counts are scaled up when
+// the kernel had to multiplex more counters than the PMU has.
+class PerfCounters {
+ public:
+  PerfCounters();
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  // Whether any counter could be opened
+  bool available() const;
+
+  void start();
+  void stop();
+
+  PerfCounterValues read() const;
+
+ private:
+  static constexpr size_t kCount = static_cast<size_t>(PerfCounter::COUNT);
+
+  std::array<int, kCount> fds_;
+  // The descriptor each counter is read through, which is the one of the
+  // group leader or its own, and its position among the counts read
+  std::array<int, kCount> groupFds_;
+  std::array<size_t, kCount> groupIndices_;
+};
+
+} // namespace facebook::yoga
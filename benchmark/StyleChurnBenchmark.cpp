@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <chrono>
+#include <cstdio>
+
+#include <benchmark/Benchmark.h>
+#include <yoga/node/Node.h>
+
+namespace facebook::yoga {
+
+using namespace std::chrono;
+
+constexpr uint32_t kNumChurnFrames = 100000;
+
+// Animates a handful of style properties of one node through fractional
+// values, with occasional switches to keywords and integers, as an animation
+// driver would. Reports the setter cost and the size of the style value pool,
+// which should stay bounded no matter how many frames are run.
+void styleChurnBenchmark() {
+  std::printf("Starting benchmark for style churn\n");
+  YGNodeRef node = YGNodeNew();
+
+  auto begin = steady_clock::now();
+  for (uint32_t frame = 1; frame <= kNumChurnFrames; frame++) {
+    const float progress = static_cast<float>(frame % 1000) / 7.0f + 0.5f;
+    if (frame % 5 == 0) {
+      YGNodeStyleSetWidthAuto(node);
+    } else {
+      YGNodeStyleSetWidth(node, 100.0f + progress);
+    }
+    if (frame % 7 == 0) {
+      YGNodeStyleSetHeightFitContent(node);
+    } else {
+      YGNodeStyleSetHeightPercent(node, progress / 10.0f);
+    }
+    YGNodeStyleSetPosition(node, YGEdgeLeft, static_cast<float>(frame % 50));
+    YGNodeStyleSetFlexGrow(node, progress);
+
+    if (frame == 1 || frame == 1000 || frame == kNumChurnFrames) {
+      std::printf(
+          "style churn pool size after %u frames: %zu slots\n",
+          frame,
+          resolveRef(node)->style().valuePoolSize());
+    }
+  }
+  auto end = steady_clock::now();
+
+  std::printf(
+      "style churn: %lf ns per frame\n",
+      duration<double, std::nano>(end - begin).count() / kNumChurnFrames);
+  std::printf("\n");
+  YGNodeFree(node);
+}
+
+} // namespace facebook::yoga
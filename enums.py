@@ -62,6 +62,45 @@ ENUMS = {
         "WebFlexBasis",
     ],
     "Gutter": ["Column", "Row", "All"],
+    # How a style update affects the node, from least to most invalidating
+    "StyleChange": [
+        # The style is left as it was
+        "None",
+        # The style changes, but the layout of the tree cannot
+        "LayoutUnaffected",
+        # The tree needs to be laid out again
+        "Layout",
+    ],
+    # Style properties which can be updated in a batch by YGNodeStyleApply
+    "StyleProperty": [
+        "Direction",
+        "FlexDirection",
+        "JustifyContent",
+        "AlignContent",
+        "AlignItems",
+        "AlignSelf",
+        "PositionType",
+        "FlexWrap",
+        "Overflow",
+        "Display",
+        "BoxSizing",
+        "Flex",
+        "FlexGrow",
+        "FlexShrink",
+        "FlexBasis",
+        "Position",
+        "Margin",
+        "Padding",
+        "Border",
+        "Gap",
+        "AspectRatio",
+        "Width",
+        "Height",
+        "MinWidth",
+        "MinHeight",
+        "MaxWidth",
+        "MaxHeight",
+    ],
     # Known incorrect behavior which can be enabled for compatibility
     "Errata": [
         # Default: Standards conformant mode
@@ -7,7 +7,10 @@
 
 #include <fuzzer/FuzzedDataProvider.h>
 #include <yoga/Yoga.h>
+#include <yoga/config/Config.h>
+#include <cmath>
 #include <cstdint>
+#include <cstdlib>
 
 YGFlexDirection fuzzedFlexDirection(FuzzedDataProvider& fdp) {
   return fdp.PickValueInArray({
@@ -18,6 +21,78 @@ YGFlexDirection fuzzedFlexDirection(FuzzedDataProvider& fdp) {
   });
 }
 
+YGAlign fuzzedAlign(FuzzedDataProvider& fdp) {
+  return fdp.PickValueInArray({
+      YGAlignAuto,
+      YGAlignFlexStart,
+      YGAlignCenter,
+      YGAlignFlexEnd,
+      YGAlignStretch,
+      YGAlignBaseline,
+  });
+}
+
+YGJustify fuzzedJustify(FuzzedDataProvider& fdp) {
+  return fdp.PickValueInArray({
+      YGJustifyFlexStart,
+      YGJustifyCenter,
+      YGJustifyFlexEnd,
+      YGJustifySpaceBetween,
+      YGJustifySpaceAround,
+      YGJustifySpaceEvenly,
+  });
+}
+
+// Mostly produces the kind of styles simple containers are made of, with
+// the occasional flexible, wrapping, absolute or auto-margin node so that
+// both the fast path and the general algorithm are exercised.
+void fillFuzzedStyle(FuzzedDataProvider& fdp, YGNodeRef node) {
+  if (fdp.ConsumeBool()) {
+    YGNodeStyleSetJustifyContent(node, fuzzedJustify(fdp));
+  }
+  if (fdp.ConsumeBool()) {
+    YGNodeStyleSetAlignItems(node, fuzzedAlign(fdp));
+  }
+  if (fdp.ConsumeBool()) {
+    YGNodeStyleSetAlignSelf(node, fuzzedAlign(fdp));
+  }
+  if (fdp.ConsumeBool()) {
+    YGNodeStyleSetMargin(
+        node, YGEdgeAll, fdp.ConsumeFloatingPointInRange<float>(-10, 10));
+  }
+  if (fdp.ConsumeBool()) {
+    YGNodeStyleSetPadding(
+        node, YGEdgeStart, fdp.ConsumeFloatingPointInRange<float>(0, 10));
+  }
+  if (fdp.ConsumeBool()) {
+    YGNodeStyleSetMinWidth(
+        node, fdp.ConsumeFloatingPointInRange<float>(0, 100));
+  }
+  if (fdp.ConsumeBool()) {
+    YGNodeStyleSetMaxHeight(
+        node, fdp.ConsumeFloatingPointInRange<float>(0, 100));
+  }
+  if (fdp.ConsumeProbability<float>() < 0.1f) {
+    YGNodeStyleSetFlexGrow(node, fdp.ConsumeFloatingPointInRange<float>(0, 2));
+  }
+  if (fdp.ConsumeProbability<float>() < 0.1f) {
+    YGNodeStyleSetFlexShrink(
+        node, fdp.ConsumeFloatingPointInRange<float>(0, 2));
+  }
+  if (fdp.ConsumeProbability<float>() < 0.1f) {
+    YGNodeStyleSetFlexWrap(node, YGWrapWrap);
+  }
+  if (fdp.ConsumeProbability<float>() < 0.1f) {
+    YGNodeStyleSetPositionType(node, YGPositionTypeAbsolute);
+  }
+  if (fdp.ConsumeProbability<float>() < 0.05f) {
+    YGNodeStyleSetDisplay(node, YGDisplayNone);
+  }
+  if (fdp.ConsumeProbability<float>() < 0.05f) {
+    YGNodeStyleSetMarginAuto(node, YGEdgeLeft);
+  }
+}
+
 void fillFuzzedTree(
     FuzzedDataProvider& fdp,
     YGConfigConstRef config,
@@ -38,19 +113,60 @@ void fillFuzzedTree(
     YGNodeStyleSetGap(
         child, YGGutterAll, fdp.ConsumeProbability<float>() * 100);
     YGNodeStyleSetHeight(child, fdp.ConsumeFloatingPoint<float>());
+    fillFuzzedStyle(fdp, child);
     YGNodeInsertChild(root, child, i);
     fillFuzzedTree(fdp, config, child, depth + 1);
   }
 }
 
+bool sameFloat(float a, float b) {
+  return (std::isnan(a) && std::isnan(b)) || a == b;
+}
+
+// The simple stack fast path must produce exactly the layout of the general
+// algorithm, so any difference between the two trees is a bug.
+void assertSameLayout(YGNodeRef a, YGNodeRef b) {
+  if (!sameFloat(YGNodeLayoutGetLeft(a), YGNodeLayoutGetLeft(b)) ||
+      !sameFloat(YGNodeLayoutGetTop(a), YGNodeLayoutGetTop(b)) ||
+      !sameFloat(YGNodeLayoutGetWidth(a), YGNodeLayoutGetWidth(b)) ||
+      !sameFloat(YGNodeLayoutGetHeight(a), YGNodeLayoutGetHeight(b)) ||
+      YGNodeLayoutGetHadOverflow(a) != YGNodeLayoutGetHadOverflow(b)) {
+    abort();
+  }
+  for (size_t i = 0; i < YGNodeGetChildCount(a); i++) {
+    assertSameLayout(YGNodeGetChild(a, i), YGNodeGetChild(b, i));
+  }
+}
+
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
   FuzzedDataProvider fdp(data, size);
   YGConfigRef config = YGConfigNew();
   YGNodeRef root = YGNodeNewWithConfig(config);
   fillFuzzedTree(fdp, config, root);
 
-  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  FuzzedDataProvider generalFdp(data, size);
+  YGConfigRef generalConfig = YGConfigNew();
+  facebook::yoga::resolveRef(generalConfig)
+      ->setSimpleStackFastPathEnabled(false);
+  YGNodeRef generalRoot = YGNodeNewWithConfig(generalConfig);
+  fillFuzzedTree(generalFdp, generalConfig, generalRoot);
+
+  const float availableWidth = fdp.ConsumeBool()
+      ? YGUndefined
+      : fdp.ConsumeFloatingPointInRange<float>(0, 1000);
+  const float availableHeight = fdp.ConsumeBool()
+      ? YGUndefined
+      : fdp.ConsumeFloatingPointInRange<float>(0, 1000);
+  const YGDirection direction =
+      fdp.PickValueInArray({YGDirectionLTR, YGDirectionRTL});
+
+  YGNodeCalculateLayout(root, availableWidth, availableHeight, direction);
+  YGNodeCalculateLayout(
+      generalRoot, availableWidth, availableHeight, direction);
+  assertSameLayout(root, generalRoot);
 
+  YGNodeFreeRecursive(generalRoot);
+  YGConfigFree(generalConfig);
   YGNodeFreeRecursive(root);
   YGConfigFree(config);
   return 0;
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// @generated by enums.py
+
+package com.facebook.yoga;
+
+public enum YogaStyleChange {
+  NONE(0),
+  LAYOUT_UNAFFECTED(1),
+  LAYOUT(2);
+
+  private final int mIntValue;
+
+  YogaStyleChange(int intValue) {
+    mIntValue = intValue;
+  }
+
+  public int intValue() {
+    return mIntValue;
+  }
+
+  public static YogaStyleChange fromInt(int value) {
+    switch (value) {
+      case 0: return NONE;
+      case 1: return LAYOUT_UNAFFECTED;
+      case 2: return LAYOUT;
+      default: throw new IllegalArgumentException("Unknown enum value: " + value);
+    }
+  }
+}
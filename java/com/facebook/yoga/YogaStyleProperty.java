@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// @generated by enums.py
+
+package com.facebook.yoga;
+
+public enum YogaStyleProperty {
+  DIRECTION(0),
+  FLEX_DIRECTION(1),
+  JUSTIFY_CONTENT(2),
+  ALIGN_CONTENT(3),
+  ALIGN_ITEMS(4),
+  ALIGN_SELF(5),
+  POSITION_TYPE(6),
+  FLEX_WRAP(7),
+  OVERFLOW(8),
+  DISPLAY(9),
+  BOX_SIZING(10),
+  FLEX(11),
+  FLEX_GROW(12),
+  FLEX_SHRINK(13),
+  FLEX_BASIS(14),
+  POSITION(15),
+  MARGIN(16),
+  PADDING(17),
+  BORDER(18),
+  GAP(19),
+  ASPECT_RATIO(20),
+  WIDTH(21),
+  HEIGHT(22),
+  MIN_WIDTH(23),
+  MIN_HEIGHT(24),
+  MAX_WIDTH(25),
+  MAX_HEIGHT(26);
+
+  private final int mIntValue;
+
+  YogaStyleProperty(int intValue) {
+    mIntValue = intValue;
+  }
+
+  public int intValue() {
+    return mIntValue;
+  }
+
+  public static YogaStyleProperty fromInt(int value) {
+    switch (value) {
+      case 0: return DIRECTION;
+      case 1: return FLEX_DIRECTION;
+      case 2: return JUSTIFY_CONTENT;
+      case 3: return ALIGN_CONTENT;
+      case 4: return ALIGN_ITEMS;
+      case 5: return ALIGN_SELF;
+      case 6: return POSITION_TYPE;
+      case 7: return FLEX_WRAP;
+      case 8: return OVERFLOW;
+      case 9: return DISPLAY;
+      case 10: return BOX_SIZING;
+      case 11: return FLEX;
+      case 12: return FLEX_GROW;
+      case 13: return FLEX_SHRINK;
+      case 14: return FLEX_BASIS;
+      case 15: return POSITION;
+      case 16: return MARGIN;
+      case 17: return PADDING;
+      case 18: return BORDER;
+      case 19: return GAP;
+      case 20: return ASPECT_RATIO;
+      case 21: return WIDTH;
+      case 22: return HEIGHT;
+      case 23: return MIN_WIDTH;
+      case 24: return MIN_HEIGHT;
+      case 25: return MAX_WIDTH;
+      case 26: return MAX_HEIGHT;
+      default: throw new IllegalArgumentException("Unknown enum value: " + value);
+    }
+  }
+}
@@ -120,6 +120,42 @@ export enum PositionType {
   Absolute = 2,
 }
 
+export enum StyleChange {
+  None = 0,
+  LayoutUnaffected = 1,
+  Layout = 2,
+}
+
+export enum StyleProperty {
+  Direction = 0,
+  FlexDirection = 1,
+  JustifyContent = 2,
+  AlignContent = 3,
+  AlignItems = 4,
+  AlignSelf = 5,
+  PositionType = 6,
+  FlexWrap = 7,
+  Overflow = 8,
+  Display = 9,
+  BoxSizing = 10,
+  Flex = 11,
+  FlexGrow = 12,
+  FlexShrink = 13,
+  FlexBasis = 14,
+  Position = 15,
+  Margin = 16,
+  Padding = 17,
+  Border = 18,
+  Gap = 19,
+  AspectRatio = 20,
+  Width = 21,
+  Height = 22,
+  MinWidth = 23,
+  MinHeight = 24,
+  MaxWidth = 25,
+  MaxHeight = 26,
+}
+
 export enum Unit {
   Undefined = 0,
   Point = 1,
@@ -202,6 +238,36 @@ const constants = {
   POSITION_TYPE_STATIC: PositionType.Static,
   POSITION_TYPE_RELATIVE: PositionType.Relative,
   POSITION_TYPE_ABSOLUTE: PositionType.Absolute,
+  STYLE_CHANGE_NONE: StyleChange.None,
+  STYLE_CHANGE_LAYOUT_UNAFFECTED: StyleChange.LayoutUnaffected,
+  STYLE_CHANGE_LAYOUT: StyleChange.Layout,
+  STYLE_PROPERTY_DIRECTION: StyleProperty.Direction,
+  STYLE_PROPERTY_FLEX_DIRECTION: StyleProperty.FlexDirection,
+  STYLE_PROPERTY_JUSTIFY_CONTENT: StyleProperty.JustifyContent,
+  STYLE_PROPERTY_ALIGN_CONTENT: StyleProperty.AlignContent,
+  STYLE_PROPERTY_ALIGN_ITEMS: StyleProperty.AlignItems,
+  STYLE_PROPERTY_ALIGN_SELF: StyleProperty.AlignSelf,
+  STYLE_PROPERTY_POSITION_TYPE: StyleProperty.PositionType,
+  STYLE_PROPERTY_FLEX_WRAP: StyleProperty.FlexWrap,
+  STYLE_PROPERTY_OVERFLOW: StyleProperty.Overflow,
+  STYLE_PROPERTY_DISPLAY: StyleProperty.Display,
+  STYLE_PROPERTY_BOX_SIZING: StyleProperty.BoxSizing,
+  STYLE_PROPERTY_FLEX: StyleProperty.Flex,
+  STYLE_PROPERTY_FLEX_GROW: StyleProperty.FlexGrow,
+  STYLE_PROPERTY_FLEX_SHRINK: StyleProperty.FlexShrink,
+  STYLE_PROPERTY_FLEX_BASIS: StyleProperty.FlexBasis,
+  STYLE_PROPERTY_POSITION: StyleProperty.Position,
+  STYLE_PROPERTY_MARGIN: StyleProperty.Margin,
+  STYLE_PROPERTY_PADDING: StyleProperty.Padding,
+  STYLE_PROPERTY_BORDER: StyleProperty.Border,
+  STYLE_PROPERTY_GAP: StyleProperty.Gap,
+  STYLE_PROPERTY_ASPECT_RATIO: StyleProperty.AspectRatio,
+  STYLE_PROPERTY_WIDTH: StyleProperty.Width,
+  STYLE_PROPERTY_HEIGHT: StyleProperty.Height,
+  STYLE_PROPERTY_MIN_WIDTH: StyleProperty.MinWidth,
+  STYLE_PROPERTY_MIN_HEIGHT: StyleProperty.MinHeight,
+  STYLE_PROPERTY_MAX_WIDTH: StyleProperty.MaxWidth,
+  STYLE_PROPERTY_MAX_HEIGHT: StyleProperty.MaxHeight,
   UNIT_UNDEFINED: Unit.Undefined,
   UNIT_POINT: Unit.Point,
   UNIT_PERCENT: Unit.Percent,
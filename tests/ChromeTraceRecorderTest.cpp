@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+#include <yoga/event/ChromeTraceRecorder.h>
+
+#include "util/TestUtil.h"
+
+namespace facebook::yoga {
+
+static size_t countOf(const std::string& text, const std::string& pattern) {
+  size_t count = 0;
+  for (auto i = text.find(pattern); i != std::string::npos;
+       i = text.find(pattern, i + pattern.size())) {
+    count++;
+  }
+  return count;
+}
+
+static YGNodeRef createTree() {
+  YGNodeRef root = test::createMeasuredRow();
+  YGNodeStyleSetAlignItems(root, YGAlignBaseline);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeSetBaselineFunc(
+      YGNodeGetChild(root, 0),
+      [](YGNodeConstRef, float, float) { return 8.0f; });
+  return root;
+}
+
+TEST(ChromeTraceRecorder, records_spans_of_layout_passes) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  std::string trace;
+  {
+    ChromeTraceRecorder recorder;
+    YGNodeRef root = createTree();
+    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+    YGNodeFreeRecursive(root);
+
+    std::ostringstream out;
+    recorder.writeChromeTrace(out);
+    trace = out.str();
+    ASSERT_EQ(recorder.size(), countOf(trace, "\"ph\":"));
+  }
+
+  ASSERT_EQ(0u, trace.find("{\"traceEvents\":["));
+  ASSERT_EQ(countOf(trace, "\"ph\":\"B\""), countOf(trace, "\"ph\":\"E\""));
+  ASSERT_EQ(2u, countOf(trace, "\"name\":\"layout_pass\""));
+  ASSERT_EQ(2u, countOf(trace, "\"name\":\"initial\""));
+  ASSERT_EQ(2u, countOf(trace, "\"name\":\"baseline_callback\""));
+  ASSERT_LT(0u, countOf(trace, "\"name\":\"measure_callback\""));
+  ASSERT_LT(0u, countOf(trace, "\"measured_width\":40"));
+  ASSERT_EQ(1u, countOf(trace, "\"measure_callbacks\":1"));
+}
+
+TEST(ChromeTraceRecorder, stops_recording_when_destroyed) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  auto recorder = std::make_unique<ChromeTraceRecorder>();
+  YGNodeRef root = createTree();
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_LT(0u, recorder->size());
+
+  recorder->clear();
+  ASSERT_EQ(0u, recorder->size());
+  recorder.reset();
+  ASSERT_FALSE(Event::hasSubscribers(Event::LayoutPassStart));
+
+  ChromeTraceRecorder other;
+  YGNodeStyleSetWidth(root, 200);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  std::ostringstream out;
+  other.writeChromeTrace(out);
+  ASSERT_EQ(other.size(), countOf(out.str(), "\"ph\":"));
+
+  YGNodeFreeRecursive(root);
+}
+
+} // namespace facebook::yoga
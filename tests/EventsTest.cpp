@@ -8,6 +8,7 @@
 #include <gtest/gtest.h>
 #include <yoga/YGEnums.h>
 #include <yoga/Yoga.h>
+#include <yoga/debug/AllocationCounter.h>
 #include <yoga/event/event.h>
 
 #include <algorithm>
@@ -45,7 +46,12 @@ struct EventArgs {
 };
 
 class EventTest : public ::testing::Test {
-  ScopedEventSubscription subscription{&EventTest::listen};
+  // Node visits are followed through the NodeLayout events which end them,
+  // and dirtying is followed by the tests of it
+  ScopedEventSubscription subscription{
+      &EventTest::listen,
+      Event::allTypes &
+          ~Event::typeMask<Event::NodeLayoutStart, Event::NodeDirtied>()};
   static void listen(
       YGNodeConstRef /*node*/,
       Event::Type /*type*/,
@@ -56,6 +62,7 @@ class EventTest : public ::testing::Test {
   static EventArgs& lastEvent() {
     return events.back();
   }
+  void SetUp() override;
   void TearDown() override;
 };
 
@@ -248,6 +255,37 @@ TEST_F(EventTest, layout_events_has_max_measure_cache) {
   ASSERT_EQ(layoutData.layouts, 3);
   ASSERT_EQ(layoutData.measures, 3);
   ASSERT_EQ(layoutData.maxMeasureCache, 7);
+  ASSERT_EQ(layoutData.measureCacheEvictions, 0);
+}
+
+TEST_F(EventTest, layout_events_count_allocations) {
+  auto root = YGNodeNew();
+  YGNodeStyleSetFlexWrap(root, YGWrapWrap);
+  for (size_t i = 0; i < 3; i++) {
+    auto child = YGNodeNew();
+    YGNodeStyleSetWidth(child, 40);
+    YGNodeStyleSetHeight(child, 10);
+    YGNodeInsertChild(root, child, i);
+  }
+
+  YGNodeCalculateLayout(root, 100, YGUndefined, YGDirectionLTR);
+  LayoutData layoutData =
+      lastEvent().eventTestData<Event::LayoutPassEnd>().layoutData;
+  if constexpr (kCountAllocations) {
+    ASSERT_LT(0u, layoutData.allocations);
+    ASSERT_LE(layoutData.allocations, layoutData.allocatedBytes);
+  } else {
+    ASSERT_EQ(0u, layoutData.allocations);
+    ASSERT_EQ(0u, layoutData.allocatedBytes);
+  }
+
+  // Relayout served from the cache allocates nothing
+  YGNodeCalculateLayout(root, 100, YGUndefined, YGDirectionLTR);
+  layoutData = lastEvent().eventTestData<Event::LayoutPassEnd>().layoutData;
+  ASSERT_EQ(0u, layoutData.allocations);
+  ASSERT_EQ(0u, layoutData.allocatedBytes);
+
+  YGNodeFreeRecursive(root);
 }
 
 TEST_F(EventTest, measure_functions_get_wrapped) {
@@ -285,6 +323,183 @@ TEST_F(EventTest, baseline_functions_get_wrapped) {
   ASSERT_EQ(events[events.size() - 1].type, Event::LayoutPassEnd);
 }
 
+TEST_F(EventTest, nothing_is_published_without_subscribers) {
+  ASSERT_TRUE(Event::hasSubscribers(Event::NodeAllocation));
+  ASSERT_TRUE(Event::hasSubscribers(Event::NodeLayout));
+
+  Event::reset();
+  ASSERT_FALSE(Event::hasSubscribers(Event::NodeAllocation));
+  ASSERT_FALSE(Event::hasSubscribers(Event::NodeLayout));
+
+  auto root = YGNodeNew();
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeFree(root);
+  ASSERT_TRUE(events.empty());
+}
+
+TEST_F(EventTest, subscribers_only_receive_types_they_subscribe_to) {
+  Event::reset();
+  std::vector<Event::Type> baselineEvents;
+  Event::subscribe(
+      [&](YGNodeConstRef, Event::Type type, Event::Data) {
+        baselineEvents.push_back(type);
+      },
+      Event::typeMask<Event::NodeBaselineStart, Event::NodeBaselineEnd>());
+  ASSERT_TRUE(Event::hasSubscribers(Event::NodeBaselineEnd));
+  ASSERT_FALSE(Event::hasSubscribers(Event::NodeLayout));
+
+  auto root = YGNodeNew();
+  auto child = YGNodeNew();
+  YGNodeInsertChild(root, child, 0);
+  YGNodeSetBaselineFunc(
+      child, [](YGNodeConstRef, float, float) { return 0.0f; });
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetAlignItems(root, YGAlignBaseline);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeFreeRecursive(root);
+
+  const std::vector<Event::Type> expected = {
+      Event::NodeBaselineStart, Event::NodeBaselineEnd};
+  ASSERT_EQ(expected, baselineEvents);
+  ASSERT_TRUE(events.empty());
+}
+
+TEST_F(EventTest, unsubscribing_releases_only_that_subscriber) {
+  auto owned = std::make_shared<int>(0);
+  const auto subscription = Event::subscribe(
+      [owned](YGNodeConstRef, Event::Type, Event::Data) { (*owned)++; },
+      Event::typeMask<Event::NodeBaselineStart, Event::NodeLayout>());
+  ASSERT_EQ(2, owned.use_count());
+
+  // The fixture is still subscribed to node layouts
+  Event::unsubscribe(subscription);
+  ASSERT_TRUE(Event::hasSubscribers(Event::NodeLayout));
+  ASSERT_EQ(1, owned.use_count());
+
+  auto root = YGNodeNew();
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeFree(root);
+  ASSERT_EQ(0, *owned);
+  ASSERT_FALSE(events.empty());
+}
+
+TEST_F(EventTest, unsubscribing_drops_types_nothing_else_subscribes_to) {
+  Event::reset();
+  const auto baselines = Event::subscribe(
+      [](YGNodeConstRef, Event::Type, Event::Data) {},
+      Event::typeMask<Event::NodeBaselineStart, Event::NodeLayout>());
+  const auto layouts = Event::subscribe(
+      [](YGNodeConstRef, Event::Type, Event::Data) {},
+      Event::typeMask<Event::NodeLayout>());
+
+  Event::unsubscribe(baselines);
+  ASSERT_FALSE(Event::hasSubscribers(Event::NodeBaselineStart));
+  ASSERT_TRUE(Event::hasSubscribers(Event::NodeLayout));
+
+  Event::unsubscribe(layouts);
+  ASSERT_FALSE(Event::hasSubscribers(Event::NodeLayout));
+}
+
+TEST_F(EventTest, subscribers_can_unsubscribe_while_published_to) {
+  auto owned = std::make_shared<int>(0);
+  Event::SubscriptionId subscription = 0;
+  subscription = Event::subscribe(
+      [owned, &subscription](YGNodeConstRef, Event::Type, Event::Data) {
+        (*owned)++;
+        Event::unsubscribe(subscription);
+      },
+      Event::typeMask<Event::NodeLayout>());
+
+  auto root = YGNodeNew();
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeFree(root);
+  ASSERT_EQ(1, *owned);
+  ASSERT_EQ(1, owned.use_count());
+}
+
+TEST_F(EventTest, node_layout_events_enclose_node_visits) {
+  auto root = YGNodeNew();
+  auto child = YGNodeNew();
+  YGNodeInsertChild(root, child, 0);
+
+  std::vector<std::pair<YGNodeConstRef, LayoutPassReason>> visits;
+  Event::subscribe(
+      [&](YGNodeConstRef node, Event::Type type, Event::Data data) {
+        const auto reason = type == Event::NodeLayoutStart
+            ? data.get<Event::NodeLayoutStart>().reason
+            : data.get<Event::NodeLayout>().reason;
+        visits.emplace_back(node, reason);
+      },
+      Event::typeMask<Event::NodeLayoutStart, Event::NodeLayout>());
+  YGNodeCalculateLayout(root, 123, 456, YGDirectionLTR);
+
+  // The root visit starts first and ends last, around each child visit
+  ASSERT_EQ(8u, visits.size());
+  ASSERT_EQ(root, visits.front().first);
+  ASSERT_EQ(LayoutPassReason::kInitial, visits.front().second);
+  ASSERT_EQ(root, visits.back().first);
+  ASSERT_EQ(LayoutPassReason::kInitial, visits.back().second);
+  for (size_t i = 1; i + 1 < visits.size(); i += 2) {
+    ASSERT_EQ(child, visits[i].first);
+    ASSERT_EQ(visits[i].second, visits[i + 1].second);
+  }
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST_F(EventTest, node_dirtied_events_carry_origin_and_propagation) {
+  auto root = YGNodeNew();
+  auto child = YGNodeNew();
+  YGNodeInsertChild(root, child, 0);
+  auto grandchild = YGNodeNew();
+  YGNodeInsertChild(child, grandchild, 0);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  std::vector<std::pair<YGNodeConstRef, Event::TypedData<Event::NodeDirtied>>>
+      dirtied;
+  Event::subscribe(
+      [&](YGNodeConstRef node, Event::Type, Event::Data data) {
+        dirtied.emplace_back(node, data.get<Event::NodeDirtied>());
+      },
+      Event::typeMask<Event::NodeDirtied>());
+
+  YGNodeStyleSetWidth(grandchild, 10);
+  ASSERT_EQ(1u, dirtied.size());
+  ASSERT_EQ(grandchild, dirtied[0].first);
+  ASSERT_EQ(DirtyReason::kStyleChange, dirtied[0].second.reason);
+  ASSERT_EQ(2u, dirtied[0].second.ancestorsDirtied);
+  ASSERT_EQ(root, dirtied[0].second.topmostDirtied);
+
+  // Dirtying stops at the first dirty ancestor, and dirty nodes publish
+  // nothing
+  YGNodeStyleSetHeight(grandchild, 10);
+  auto sibling = YGNodeNew();
+  YGNodeInsertChild(root, sibling, 1);
+  ASSERT_EQ(1u, dirtied.size());
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  YGNodeRemoveChild(child, grandchild);
+  ASSERT_EQ(2u, dirtied.size());
+  ASSERT_EQ(child, dirtied[1].first);
+  ASSERT_EQ(DirtyReason::kChildRemove, dirtied[1].second.reason);
+  ASSERT_EQ(1u, dirtied[1].second.ancestorsDirtied);
+  ASSERT_EQ(root, dirtied[1].second.topmostDirtied);
+
+  // A clean node under a dirty ancestor dirties nothing else
+  auto config = YGConfigNew();
+  YGConfigSetPointScaleFactor(config, 3);
+  YGNodeSetConfig(sibling, config);
+  ASSERT_EQ(3u, dirtied.size());
+  ASSERT_EQ(sibling, dirtied[2].first);
+  ASSERT_EQ(DirtyReason::kConfigChange, dirtied[2].second.reason);
+  ASSERT_EQ(0u, dirtied[2].second.ancestorsDirtied);
+  ASSERT_EQ(sibling, dirtied[2].second.topmostDirtied);
+
+  YGNodeFreeRecursive(root);
+  YGNodeFree(grandchild);
+  YGConfigFree(config);
+}
+
 namespace {
 
 template <Event::Type E>
@@ -349,6 +564,18 @@ void EventTest::listen(
     case Event::NodeBaselineEnd:
       events.push_back(createArgs<Event::NodeBaselineEnd>(node, data));
       break;
+    case Event::NodeLayoutStart:
+      events.push_back(createArgs<Event::NodeLayoutStart>(node, data));
+      break;
+    case Event::NodeDirtied:
+      events.push_back(createArgs<Event::NodeDirtied>(node, data));
+      break;
+  }
+}
+
+void EventTest::SetUp() {
+  if (!Event::enabled) {
+    GTEST_SKIP();
   }
 }
 
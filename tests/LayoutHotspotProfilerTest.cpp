@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+#include <yoga/event/LayoutHotspotProfiler.h>
+
+#include "util/TestUtil.h"
+
+namespace facebook::yoga {
+
+// A row around a container, itself a row around a measured leaf
+static YGNodeRef createTree() {
+  YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeInsertChild(root, test::createMeasuredRow(), 0);
+  return root;
+}
+
+TEST(LayoutHotspotProfiler, attributes_time_to_subtrees_and_reasons) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  LayoutHotspotProfiler profiler;
+  YGNodeRef root = createTree();
+  YGNodeRef container = YGNodeGetChild(root, 0);
+  YGNodeRef text = YGNodeGetChild(container, 0);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  const auto subtrees = profiler.costliestSubtrees(10);
+  ASSERT_EQ(3u, subtrees.size());
+  ASSERT_EQ(root, subtrees[0].node);
+  for (size_t i = 1; i < subtrees.size(); i++) {
+    ASSERT_GE(
+        subtrees[i - 1].total.inclusiveTime, subtrees[i].total.inclusiveTime);
+  }
+
+  const auto& rootHotspot = subtrees[0];
+  ASSERT_EQ(1u, rootHotspot.total.visits);
+  ASSERT_EQ(
+      1u,
+      rootHotspot.byReason[static_cast<size_t>(LayoutPassReason::kInitial)]
+          .visits);
+  ASSERT_LE(rootHotspot.total.selfTime, rootHotspot.total.inclusiveTime);
+
+  const auto textHotspot = std::find_if(
+      subtrees.begin(), subtrees.end(), [&](const auto& subtree) {
+        return subtree.node == text;
+      });
+  ASSERT_NE(subtrees.end(), textHotspot);
+  ASSERT_LT(0u, textHotspot->total.measureCallbacks);
+  ASSERT_EQ(textHotspot->total.selfTime, textHotspot->total.inclusiveTime);
+  ASSERT_LE(
+      textHotspot->total.measureCallbackTime, textHotspot->total.selfTime);
+
+  // Every visit is counted once, under the reason for the visit, and nested
+  // visits do not count towards the time of the visits around them
+  const auto reasons = profiler.reasons();
+  uint32_t visits = 0;
+  std::chrono::nanoseconds selfTime{};
+  for (const auto& subtree : subtrees) {
+    visits += subtree.total.visits;
+    selfTime += subtree.total.selfTime;
+  }
+  uint32_t visitsByReason = 0;
+  std::chrono::nanoseconds selfTimeByReason{};
+  for (const auto& reason : reasons) {
+    visitsByReason += reason.visits;
+    selfTimeByReason += reason.selfTime;
+    ASSERT_EQ(0, reason.inclusiveTime.count());
+  }
+  ASSERT_EQ(visits, visitsByReason);
+  ASSERT_EQ(selfTime, selfTimeByReason);
+  ASSERT_LT(
+      0u, reasons[static_cast<size_t>(LayoutPassReason::kMeasureChild)].visits);
+
+  ASSERT_EQ(1u, profiler.costliestSubtrees(1).size());
+
+  YGNodeFreeRecursive(root);
+  ASSERT_TRUE(profiler.costliestSubtrees(10).empty());
+}
+
+TEST(LayoutHotspotProfiler, writes_report) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  LayoutHotspotProfiler profiler;
+  YGNodeRef root = createTree();
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  std::ostringstream report;
+  profiler.writeReport(report, 2);
+  const std::string text = report.str();
+  ASSERT_NE(std::string::npos, text.find("Layout time by reason"));
+  ASSERT_NE(std::string::npos, text.find("reason                 visits  "));
+  ASSERT_NE(std::string::npos, text.find("\ninitial "));
+  ASSERT_NE(std::string::npos, text.find("\nmeasure "));
+  ASSERT_NE(std::string::npos, text.find("Costliest subtrees"));
+
+  const auto subtrees = text.substr(text.find("Costliest subtrees"));
+  ASSERT_EQ(4, std::count(subtrees.begin(), subtrees.end(), '\n'));
+
+  profiler.clear();
+  ASSERT_TRUE(profiler.costliestSubtrees(10).empty());
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(LayoutHotspotProfiler, stops_when_destroyed) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  {
+    LayoutHotspotProfiler profiler;
+    ASSERT_TRUE(Event::hasSubscribers(Event::NodeLayoutStart));
+  }
+  ASSERT_FALSE(Event::hasSubscribers(Event::NodeLayoutStart));
+}
+
+} // namespace facebook::yoga
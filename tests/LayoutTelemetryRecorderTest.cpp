@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <set>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+#include <yoga/event/LayoutTelemetryRecorder.h>
+
+#include "util/TestUtil.h"
+
+namespace facebook::yoga {
+
+TEST(LayoutTelemetryRecorder, records_spans_which_ended) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  LayoutTelemetryRecorder recorder;
+  YGNodeRef root = test::createMeasuredRow();
+  YGNodeRef text = YGNodeGetChild(root, 0);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  const auto records = recorder.records();
+  ASSERT_LT(3u, records.size());
+  const auto& pass = records.back();
+  ASSERT_EQ(Event::LayoutPassEnd, pass.type);
+  ASSERT_EQ(root, pass.node);
+  ASSERT_EQ(1, pass.thread);
+
+  const auto& rootVisit = records[records.size() - 2];
+  ASSERT_EQ(Event::NodeLayout, rootVisit.type);
+  ASSERT_EQ(root, rootVisit.node);
+  ASSERT_EQ(LayoutPassReason::kInitial, rootVisit.reason);
+  ASSERT_EQ(LayoutType::kLayout, rootVisit.layoutType);
+  ASSERT_LE(rootVisit.duration, pass.duration);
+  ASSERT_LE(rootVisit.end, pass.end);
+
+  const auto measure = std::find_if(
+      records.begin(), records.end(), [](const auto& record) {
+        return record.type == Event::MeasureCallbackEnd;
+      });
+  ASSERT_NE(records.end(), measure);
+  ASSERT_EQ(text, measure->node);
+  ASSERT_EQ(LayoutPassReason::kMeasureChild, measure->reason);
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(LayoutTelemetryRecorder, keeps_most_recent_records) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  LayoutTelemetryRecorder recorder{3};
+  YGNodeRef root = test::createMeasuredRow();
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // Capacity is rounded up to a power of two
+  const auto records = recorder.records();
+  ASSERT_EQ(4u, records.size());
+  ASSERT_EQ(Event::LayoutPassEnd, records.back().type);
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(LayoutTelemetryRecorder, records_deeply_nested_spans_without_duration) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  LayoutTelemetryRecorder recorder;
+  YGNodeRef root = YGNodeNew();
+  YGNodeRef leaf = root;
+  for (size_t i = 0; i < LayoutTelemetryRecorder::kMaxTimedDepth; i++) {
+    YGNodeRef child = YGNodeNew();
+    YGNodeInsertChild(leaf, child, 0);
+    leaf = child;
+  }
+  YGNodeStyleSetWidth(leaf, 10);
+  YGNodeStyleSetHeight(leaf, 10);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // The visits of the leaf are nested in the layout pass and the visits of
+  // every node above it
+  size_t leafVisits = 0;
+  for (const auto& record : recorder.records()) {
+    if (record.node == leaf) {
+      ASSERT_EQ(std::chrono::nanoseconds{0}, record.duration);
+      leafVisits++;
+    }
+  }
+  ASSERT_LT(0u, leafVisits);
+  ASSERT_EQ(Event::LayoutPassEnd, recorder.records().back().type);
+  ASSERT_LT(std::chrono::nanoseconds{0}, recorder.records().back().duration);
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(LayoutTelemetryRecorder, hands_over_records_of_slow_passes) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  std::vector<std::vector<LayoutTelemetryRecord>> slowPasses;
+  YGNodeRef root = test::createMeasuredRow();
+  {
+    LayoutTelemetryRecorder recorder{
+        64, std::chrono::hours{1}, [&](auto records) {
+          slowPasses.push_back(std::move(records));
+        }};
+    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+    ASSERT_TRUE(slowPasses.empty());
+  }
+  {
+    LayoutTelemetryRecorder recorder{
+        64, std::chrono::nanoseconds{0}, [&](auto records) {
+          slowPasses.push_back(std::move(records));
+        }};
+    YGNodeStyleSetWidth(root, 50);
+    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+    ASSERT_EQ(1u, slowPasses.size());
+    ASSERT_EQ(recorder.records().size(), slowPasses[0].size());
+    ASSERT_EQ(Event::LayoutPassEnd, slowPasses[0].back().type);
+  }
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(LayoutTelemetryRecorder, records_each_thread_separately) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  LayoutTelemetryRecorder recorder;
+  const auto layout = [] {
+    YGNodeRef root = test::createMeasuredRow();
+    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+    YGNodeFreeRecursive(root);
+  };
+  std::thread first{layout};
+  std::thread second{layout};
+  first.join();
+  second.join();
+
+  std::set<uint16_t> threads;
+  size_t passes = 0;
+  for (const auto& record : recorder.records()) {
+    threads.insert(record.thread);
+    passes += record.type == Event::LayoutPassEnd ? 1 : 0;
+  }
+  ASSERT_EQ((std::set<uint16_t>{1, 2}), threads);
+  ASSERT_EQ(2u, passes);
+}
+
+TEST(LayoutTelemetryRecorder, recorders_record_side_by_side) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  YGNodeRef root = test::createMeasuredRow();
+  {
+    LayoutTelemetryRecorder first;
+    LayoutTelemetryRecorder second;
+    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+    ASSERT_FALSE(first.records().empty());
+    ASSERT_EQ(first.records().size(), second.records().size());
+  }
+  ASSERT_FALSE(Event::hasSubscribers(Event::LayoutPassStart));
+
+  YGNodeFreeRecursive(root);
+}
+
+} // namespace facebook::yoga
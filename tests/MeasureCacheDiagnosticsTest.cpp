@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <numeric>
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+#include <yoga/event/MeasureCacheDiagnostics.h>
+
+#include "util/TestUtil.h"
+
+namespace facebook::yoga {
+
+static YGNodeRef createTree() {
+  YGNodeRef root = test::createMeasuredRow(
+      [](YGNodeConstRef, float width, YGMeasureMode, float, YGMeasureMode) {
+        return YGSize{width / 2, 10};
+      });
+  YGNodeStyleSetAlignItems(root, YGAlignFlexStart);
+  return root;
+}
+
+static uint32_t measurementCacheHits(const MeasureCacheStatistics& stats) {
+  return std::accumulate(
+      stats.measurementCacheHits.begin(), stats.measurementCacheHits.end(), 0u);
+}
+
+TEST(MeasureCacheDiagnostics, counts_cache_hits_and_misses) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  MeasureCacheDiagnostics diagnostics;
+  YGNodeRef root = createTree();
+  YGNodeRef text = YGNodeGetChild(root, 0);
+
+  YGNodeCalculateLayout(root, 100, 100, YGDirectionLTR);
+  const auto first = diagnostics.statistics(text);
+  ASSERT_TRUE(first.has_value());
+  ASSERT_LT(0u, first->misses);
+  ASSERT_EQ(0u, first->evictions);
+
+  YGNodeCalculateLayout(root, 100, 100, YGDirectionLTR);
+  YGNodeMarkDirty(text);
+  YGNodeCalculateLayout(root, 100, 100, YGDirectionLTR);
+  const auto stats = diagnostics.statistics(text);
+  ASSERT_TRUE(stats.has_value());
+  ASSERT_EQ(
+      stats->lookups,
+      stats->layoutCacheHits + measurementCacheHits(*stats) + stats->misses);
+  ASSERT_LT(first->misses, stats->misses);
+  ASSERT_LT(0u, stats->invalidations);
+  ASSERT_TRUE(diagnostics.thrashingNodes().empty());
+
+  YGNodeFreeRecursive(root);
+  ASSERT_FALSE(diagnostics.statistics(root).has_value());
+  ASSERT_FALSE(diagnostics.statistics(text).has_value());
+}
+
+TEST(MeasureCacheDiagnostics, finds_nodes_whose_measurement_cache_thrashes) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  MeasureCacheDiagnostics diagnostics;
+  YGNodeRef root = createTree();
+  YGNodeRef text = YGNodeGetChild(root, 0);
+
+  for (int width = 100; width < 150; width += 2) {
+    YGNodeCalculateLayout(
+        root, static_cast<float>(width), YGUndefined, YGDirectionLTR);
+  }
+
+  const auto thrashing = diagnostics.thrashingNodes();
+  ASSERT_FALSE(thrashing.empty());
+  ASSERT_EQ(text, thrashing.front().first);
+  ASSERT_LT(1u, thrashing.front().second.evictions);
+  ASSERT_TRUE(diagnostics
+                  .thrashingNodes(thrashing.front().second.evictions + 1)
+                  .empty());
+
+  diagnostics.clear();
+  ASSERT_FALSE(diagnostics.statistics(text).has_value());
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(MeasureCacheDiagnostics, stops_when_destroyed) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  YGNodeRef root = createTree();
+  {
+    MeasureCacheDiagnostics diagnostics;
+  }
+  ASSERT_FALSE(Event::hasSubscribers(Event::NodeLayout));
+
+  MeasureCacheDiagnostics diagnostics;
+  YGNodeCalculateLayout(root, 100, 100, YGDirectionLTR);
+  ASSERT_EQ(1u, diagnostics.statistics(root)->lookups);
+
+  YGNodeFreeRecursive(root);
+}
+
+} // namespace facebook::yoga
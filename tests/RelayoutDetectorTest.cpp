@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+#include <yoga/event/RelayoutDetector.h>
+
+namespace facebook::yoga {
+
+// Nested flexible containers, alternating direction, around a text node
+static YGNodeRef createTree(YGConfigConstRef config) {
+  YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeRef parent = root;
+  for (int i = 0; i < 4; i++) {
+    YGNodeRef child = YGNodeNewWithConfig(config);
+    YGNodeStyleSetFlexDirection(
+        child, i % 2 == 0 ? YGFlexDirectionColumn : YGFlexDirectionRow);
+    YGNodeStyleSetFlexGrow(child, 1);
+    YGNodeInsertChild(parent, child, 0);
+    parent = child;
+  }
+
+  YGNodeRef text = YGNodeNewWithConfig(config);
+  YGNodeSetMeasureFunc(
+      text,
+      [](YGNodeConstRef, float width, YGMeasureMode, float, YGMeasureMode) {
+        return YGSize{width / 2, 10};
+      });
+  YGNodeInsertChild(parent, text, 0);
+  return root;
+}
+
+static YGNodeRef textOf(YGNodeRef root) {
+  YGNodeRef node = root;
+  while (YGNodeGetChildCount(node) > 0) {
+    node = YGNodeGetChild(node, 0);
+  }
+  return node;
+}
+
+TEST(RelayoutDetector, reports_nodes_visited_too_often_with_their_chain) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  std::vector<RelayoutReport> reports;
+  RelayoutDetector detector{
+      1, [&](const RelayoutReport& report) { reports.push_back(report); }};
+  YGNodeRef root = createTree(YGConfigGetDefault());
+  YGNodeRef text = textOf(root);
+  YGNodeCalculateLayout(root, 100, YGUndefined, YGDirectionLTR);
+
+  std::set<YGNodeConstRef> reported;
+  for (const auto& report : reports) {
+    ASSERT_EQ(2u, report.visits);
+    ASSERT_TRUE(reported.insert(report.node).second);
+    ASSERT_EQ(root, report.chain.front().node);
+    ASSERT_EQ(LayoutPassReason::kInitial, report.chain.front().reason);
+    ASSERT_EQ(report.node, report.chain.back().node);
+  }
+
+  const auto textReport = std::find_if(
+      reports.begin(), reports.end(), [&](const auto& report) {
+        return report.node == text;
+      });
+  ASSERT_NE(reports.end(), textReport);
+  ASSERT_EQ(6u, textReport->chain.size());
+  ASSERT_EQ(LayoutPassReason::kStretch, textReport->chain.back().reason);
+  uint32_t visits = 0;
+  for (uint32_t reasonVisits : textReport->visitsByReason) {
+    visits += reasonVisits;
+  }
+  ASSERT_EQ(textReport->visits, visits);
+
+  // Counts start over with every pass
+  const size_t firstPassReports = reports.size();
+  YGNodeMarkDirty(text);
+  YGNodeCalculateLayout(root, 100, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(2 * firstPassReports, reports.size());
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(RelayoutDetector, allows_visits_up_to_the_threshold) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  std::vector<RelayoutReport> reports;
+  RelayoutDetector detector{
+      RelayoutDetector::kDefaultThreshold,
+      [&](const RelayoutReport& report) { reports.push_back(report); }};
+  YGNodeRef root = createTree(YGConfigGetDefault());
+  YGNodeCalculateLayout(root, 100, YGUndefined, YGDirectionLTR);
+  ASSERT_TRUE(reports.empty());
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(RelayoutDetector, stops_when_destroyed) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  std::vector<RelayoutReport> reports;
+  {
+    RelayoutDetector detector{
+        1, [&](const RelayoutReport& report) { reports.push_back(report); }};
+  }
+  ASSERT_FALSE(Event::hasSubscribers(Event::NodeLayoutStart));
+
+  YGNodeRef root = createTree(YGConfigGetDefault());
+  YGNodeCalculateLayout(root, 100, YGUndefined, YGDirectionLTR);
+  ASSERT_TRUE(reports.empty());
+
+  YGNodeFreeRecursive(root);
+}
+
+static std::vector<std::string> warnings;
+
+static int logWarnings(
+    YGConfigConstRef /*config*/,
+    YGNodeConstRef /*node*/,
+    YGLogLevel level,
+    const char* format,
+    va_list args) {
+  if (level == YGLogLevelWarn) {
+    char message[512];
+    std::vsnprintf(message, sizeof(message), format, args);
+    warnings.emplace_back(message);
+  }
+  return 0;
+}
+
+TEST(RelayoutDetector, logs_warnings_without_handler) {
+  if (!Event::enabled) {
+    GTEST_SKIP();
+  }
+
+  warnings.clear();
+  YGConfigRef config = YGConfigNew();
+  YGConfigSetLogger(config, logWarnings);
+  RelayoutDetector detector{1};
+  YGNodeRef root = createTree(config);
+  YGNodeCalculateLayout(root, 100, YGUndefined, YGDirectionLTR);
+
+  ASSERT_FALSE(warnings.empty());
+  const auto textWarning = std::find_if(
+      warnings.begin(), warnings.end(), [](const std::string& warning) {
+        return warning.find(
+                   "through: initial > stretch > stretch > stretch > "
+                   "stretch > stretch") != std::string::npos;
+      });
+  ASSERT_NE(warnings.end(), textWarning);
+  ASSERT_NE(std::string::npos, textWarning->find("laid out 2 times"));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+} // namespace facebook::yoga
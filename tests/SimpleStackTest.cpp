@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+#include <yoga/config/Config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+using namespace facebook;
+
+namespace {
+
+using TreeBuilder = std::function<YGNodeRef(YGConfigRef)>;
+
+void expectSameLayout(YGNodeRef fast, YGNodeRef general) {
+  const auto expectSame = [](float a, float b) {
+    EXPECT_TRUE((std::isnan(a) && std::isnan(b)) || a == b) << a << " " << b;
+  };
+  expectSame(YGNodeLayoutGetLeft(fast), YGNodeLayoutGetLeft(general));
+  expectSame(YGNodeLayoutGetTop(fast), YGNodeLayoutGetTop(general));
+  expectSame(YGNodeLayoutGetWidth(fast), YGNodeLayoutGetWidth(general));
+  expectSame(YGNodeLayoutGetHeight(fast), YGNodeLayoutGetHeight(general));
+  EXPECT_EQ(
+      YGNodeLayoutGetHadOverflow(fast), YGNodeLayoutGetHadOverflow(general));
+
+  ASSERT_EQ(YGNodeGetChildCount(fast), YGNodeGetChildCount(general));
+  for (size_t i = 0; i < YGNodeGetChildCount(fast); i++) {
+    expectSameLayout(YGNodeGetChild(fast, i), YGNodeGetChild(general, i));
+  }
+}
+
+// Lays out the tree with and without the simple stack fast path, and checks
+// that both produce the same results.
+void expectSameLayoutWithFastPath(
+    const TreeBuilder& buildTree,
+    float availableWidth,
+    float availableHeight,
+    YGDirection direction = YGDirectionLTR) {
+  YGConfigRef fastConfig = YGConfigNew();
+  YGConfigRef generalConfig = YGConfigNew();
+  yoga::resolveRef(generalConfig)->setSimpleStackFastPathEnabled(false);
+
+  YGNodeRef fastRoot = buildTree(fastConfig);
+  YGNodeRef generalRoot = buildTree(generalConfig);
+  YGNodeCalculateLayout(fastRoot, availableWidth, availableHeight, direction);
+  YGNodeCalculateLayout(
+      generalRoot, availableWidth, availableHeight, direction);
+
+  expectSameLayout(fastRoot, generalRoot);
+
+  YGNodeFreeRecursive(fastRoot);
+  YGNodeFreeRecursive(generalRoot);
+  YGConfigFree(fastConfig);
+  YGConfigFree(generalConfig);
+}
+
+YGSize measureText(
+    YGNodeConstRef /*node*/,
+    float width,
+    YGMeasureMode widthMode,
+    float /*height*/,
+    YGMeasureMode /*heightMode*/) {
+  const float textWidth = 120;
+  return YGSize{
+      .width = widthMode == YGMeasureModeUndefined
+          ? textWidth
+          : std::min(width, textWidth),
+      .height = 20,
+  };
+}
+
+} // namespace
+
+TEST(SimpleStack, row_with_justify_align_margin_and_gap) {
+  for (auto justify :
+       {YGJustifyFlexStart,
+        YGJustifyCenter,
+        YGJustifyFlexEnd,
+        YGJustifySpaceBetween,
+        YGJustifySpaceAround,
+        YGJustifySpaceEvenly}) {
+    for (auto align :
+         {YGAlignFlexStart, YGAlignCenter, YGAlignFlexEnd, YGAlignStretch}) {
+      expectSameLayoutWithFastPath(
+          [=](YGConfigRef config) {
+            YGNodeRef root = YGNodeNewWithConfig(config);
+            YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+            YGNodeStyleSetJustifyContent(root, justify);
+            YGNodeStyleSetAlignItems(root, align);
+            YGNodeStyleSetPadding(root, YGEdgeStart, 7);
+            YGNodeStyleSetBorder(root, YGEdgeTop, 3);
+            YGNodeStyleSetGap(root, YGGutterColumn, 5);
+            for (int i = 0; i < 3; i++) {
+              YGNodeRef child = YGNodeNewWithConfig(config);
+              YGNodeStyleSetWidth(child, 20.0f + static_cast<float>(i) * 5);
+              if (i != 1) {
+                YGNodeStyleSetHeight(child, 10);
+              }
+              YGNodeStyleSetMargin(child, YGEdgeHorizontal, 2);
+              YGNodeInsertChild(root, child, i);
+            }
+            return root;
+          },
+          200,
+          100);
+    }
+  }
+}
+
+TEST(SimpleStack, column_with_aspect_ratio_and_constraints) {
+  expectSameLayoutWithFastPath(
+      [](YGConfigRef config) {
+        YGNodeRef root = YGNodeNewWithConfig(config);
+        YGNodeStyleSetMinHeight(root, 150);
+        YGNodeStyleSetMaxWidth(root, 90);
+
+        YGNodeRef a = YGNodeNewWithConfig(config);
+        YGNodeStyleSetHeight(a, 30);
+        YGNodeStyleSetAspectRatio(a, 2);
+        YGNodeInsertChild(root, a, 0);
+
+        YGNodeRef b = YGNodeNewWithConfig(config);
+        YGNodeStyleSetHeightPercent(b, 10);
+        YGNodeStyleSetMaxWidthPercent(b, 50);
+        YGNodeInsertChild(root, b, 1);
+
+        YGNodeRef c = YGNodeNewWithConfig(config);
+        YGNodeSetMeasureFunc(c, measureText);
+        YGNodeInsertChild(root, c, 2);
+        return root;
+      },
+      YGUndefined,
+      YGUndefined);
+}
+
+TEST(SimpleStack, rtl_row_reverse_with_out_of_flow_children) {
+  expectSameLayoutWithFastPath(
+      [](YGConfigRef config) {
+        YGNodeRef root = YGNodeNewWithConfig(config);
+        YGNodeStyleSetFlexDirection(root, YGFlexDirectionRowReverse);
+        YGNodeStyleSetJustifyContent(root, YGJustifyCenter);
+        YGNodeStyleSetPadding(root, YGEdgeEnd, 4);
+
+        YGNodeRef text = YGNodeNewWithConfig(config);
+        YGNodeSetMeasureFunc(text, measureText);
+        YGNodeInsertChild(root, text, 0);
+
+        YGNodeRef absolute = YGNodeNewWithConfig(config);
+        YGNodeStyleSetPositionType(absolute, YGPositionTypeAbsolute);
+        YGNodeStyleSetPosition(absolute, YGEdgeStart, 10);
+        YGNodeStyleSetWidth(absolute, 10);
+        YGNodeStyleSetHeight(absolute, 10);
+        YGNodeInsertChild(root, absolute, 1);
+
+        YGNodeRef hidden = YGNodeNewWithConfig(config);
+        YGNodeStyleSetDisplay(hidden, YGDisplayNone);
+        YGNodeInsertChild(root, hidden, 2);
+
+        YGNodeRef box = YGNodeNewWithConfig(config);
+        YGNodeStyleSetWidth(box, 50);
+        YGNodeStyleSetHeight(box, 50);
+        YGNodeInsertChild(root, box, 3);
+        return root;
+      },
+      100,
+      YGUndefined,
+      YGDirectionRTL);
+}
+
+TEST(SimpleStack, overflowing_row) {
+  expectSameLayoutWithFastPath(
+      [](YGConfigRef config) {
+        YGNodeRef root = YGNodeNewWithConfig(config);
+        YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+        YGNodeStyleSetJustifyContent(root, YGJustifySpaceAround);
+        for (int i = 0; i < 4; i++) {
+          YGNodeRef child = YGNodeNewWithConfig(config);
+          YGNodeStyleSetWidth(child, 40);
+          YGNodeInsertChild(root, child, i);
+        }
+        return root;
+      },
+      100,
+      100);
+}
+
+TEST(SimpleStack, containers_falling_back_to_general_algorithm) {
+  expectSameLayoutWithFastPath(
+      [](YGConfigRef config) {
+        YGNodeRef root = YGNodeNewWithConfig(config);
+        YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+        YGNodeStyleSetAlignItems(root, YGAlignBaseline);
+
+        YGNodeRef flexible = YGNodeNewWithConfig(config);
+        YGNodeStyleSetFlexGrow(flexible, 1);
+        YGNodeInsertChild(root, flexible, 0);
+
+        YGNodeRef autoMargin = YGNodeNewWithConfig(config);
+        YGNodeStyleSetMarginAuto(autoMargin, YGEdgeLeft);
+        YGNodeStyleSetWidth(autoMargin, 10);
+        YGNodeStyleSetHeight(autoMargin, 10);
+        YGNodeInsertChild(flexible, autoMargin, 0);
+
+        YGNodeRef text = YGNodeNewWithConfig(config);
+        YGNodeSetMeasureFunc(text, measureText);
+        YGNodeInsertChild(root, text, 1);
+        return root;
+      },
+      300,
+      100);
+}
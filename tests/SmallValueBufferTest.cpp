@@ -158,4 +158,58 @@ TEST(SmallValueBuffer, replace_64_with_64) {
   EXPECT_EQ(buffer.get64(buffer.replace(handle, magic2)), magic2);
 }
 
+TEST(SmallValueBuffer, push_after_free_reuses_index) {
+  uint32_t magic1 = 88567114u;
+  uint32_t magic2 = 351012214u;
+  uint32_t magic3 = 146122128u;
+
+  SmallValueBuffer<kBufferSize> buffer;
+  auto handle1 = buffer.push(magic1);
+  auto handle2 = buffer.push(magic2);
+  buffer.free(handle1);
+
+  EXPECT_EQ(buffer.push(magic3), handle1);
+  EXPECT_EQ(buffer.get32(handle1), magic3);
+  EXPECT_EQ(buffer.get32(handle2), magic2);
+  EXPECT_EQ(buffer.size(), 2);
+}
+
+TEST(SmallValueBuffer, free_at_end_shrinks) {
+  uint32_t magic32 = 88567114u;
+  uint64_t magic64 = 118712305386210ull;
+
+  SmallValueBuffer<kBufferSize> buffer;
+  auto handle32 = buffer.push(magic32);
+  std::vector<uint16_t> overflowHandles;
+  for (size_t i = 0; i < kBufferSize; i++) {
+    overflowHandles.push_back(buffer.push(magic64));
+  }
+  EXPECT_EQ(buffer.size(), 1 + 2 * kBufferSize);
+
+  for (auto it = overflowHandles.rbegin(); it != overflowHandles.rend(); it++) {
+    buffer.free(*it);
+  }
+  EXPECT_EQ(buffer.size(), 1);
+  EXPECT_EQ(buffer.get32(handle32), magic32);
+}
+
+TEST(SmallValueBuffer, replace_32_with_64_repeatedly_is_bounded) {
+  uint32_t magic32 = 88567114u;
+  uint64_t magic64 = 118712305386210ull;
+
+  SmallValueBuffer<kBufferSize> buffer;
+  auto first = buffer.push(magic32);
+  auto second = buffer.push(magic32);
+
+  for (size_t i = 0; i < 10000; i++) {
+    second = buffer.replace(second, magic64);
+    buffer.free(second);
+    second = buffer.push(magic32);
+  }
+
+  EXPECT_EQ(buffer.get32(first), magic32);
+  EXPECT_EQ(buffer.get32(second), magic32);
+  EXPECT_LE(buffer.size(), 3);
+}
+
 } // namespace facebook::yoga
@@ -41,4 +41,123 @@ TEST(Style, computed_margin_is_not_floored) {
   ASSERT_EQ(marginStart, -1.0f);
 }
 
+TEST(Style, equality_compares_size_keywords_and_box_sizing) {
+  yoga::Style a;
+  yoga::Style b;
+  a.setDimension(Dimension::Width, StyleSizeLength::ofFitContent());
+  b.setDimension(Dimension::Width, StyleSizeLength::ofStretch());
+  ASSERT_NE(a, b);
+
+  b.setDimension(Dimension::Width, StyleSizeLength::ofFitContent());
+  ASSERT_EQ(a, b);
+
+  a.setBoxSizing(BoxSizing::ContentBox);
+  ASSERT_NE(a, b);
+}
+
+TEST(Style, fingerprint_independent_of_set_order) {
+  yoga::Style a;
+  a.setFlexDirection(FlexDirection::Row);
+  a.setMargin(Edge::Left, StyleLength::points(4.0f));
+  a.setDimension(Dimension::Width, StyleSizeLength::percent(50.0f));
+  a.setFlexGrow(FloatOptional{1.0f});
+
+  yoga::Style b;
+  b.setFlexGrow(FloatOptional{1.0f});
+  b.setDimension(Dimension::Width, StyleSizeLength::points(10.0f));
+  b.setDimension(Dimension::Width, StyleSizeLength::percent(50.0f));
+  b.setMargin(Edge::Left, StyleLength::points(4.0f));
+  b.setFlexDirection(FlexDirection::Row);
+
+  ASSERT_NE(0, a.fingerprint());
+  ASSERT_EQ(a.fingerprint(), b.fingerprint());
+  ASSERT_EQ(a, b);
+
+  a.setFlexDirection(FlexDirection::Column);
+  a.setMargin(Edge::Left, StyleLength::undefined());
+  a.setDimension(Dimension::Width, StyleSizeLength::ofAuto());
+  a.setFlexGrow(FloatOptional{});
+  ASSERT_EQ(0, a.fingerprint());
+  ASSERT_EQ(a, yoga::Style{});
+}
+
+TEST(Style, fingerprint_distinguishes_properties_and_units) {
+  yoga::Style margin;
+  margin.setMargin(Edge::Left, StyleLength::points(4.0f));
+  yoga::Style padding;
+  padding.setPadding(Edge::Left, StyleLength::points(4.0f));
+  yoga::Style marginRight;
+  marginRight.setMargin(Edge::Right, StyleLength::points(4.0f));
+  yoga::Style marginPercent;
+  marginPercent.setMargin(Edge::Left, StyleLength::percent(4.0f));
+
+  ASSERT_NE(margin.fingerprint(), padding.fingerprint());
+  ASSERT_NE(margin.fingerprint(), marginRight.fingerprint());
+  ASSERT_NE(margin.fingerprint(), marginPercent.fingerprint());
+
+  yoga::Style negativeZero;
+  negativeZero.setPadding(Edge::Left, StyleLength::points(-0.0f));
+  yoga::Style zero;
+  zero.setPadding(Edge::Left, StyleLength::points(0.0f));
+  ASSERT_EQ(negativeZero.fingerprint(), zero.fingerprint());
+}
+
+TEST(Style, tracks_which_property_families_are_set) {
+  yoga::Style style;
+  ASSERT_FALSE(style.hasMargin());
+  ASSERT_FALSE(style.hasPosition());
+  ASSERT_FALSE(style.hasGap());
+  ASSERT_FALSE(style.hasMinDimension());
+  ASSERT_FALSE(style.hasMaxDimension());
+  ASSERT_FALSE(style.hasAspectRatio());
+  ASSERT_EQ(0.0f, style.computeMarginForAxis(FlexDirection::Row, 100.0f));
+
+  style.setMargin(Edge::Left, StyleLength::points(4.0f));
+  style.setMargin(Edge::Vertical, StyleLength::percent(10.0f));
+  style.setMaxDimension(Dimension::Height, StyleSizeLength::points(50.0f));
+  style.setAspectRatio(FloatOptional{0.0f});
+  ASSERT_TRUE(style.hasMargin());
+  ASSERT_FALSE(style.hasPadding());
+  ASSERT_FALSE(style.hasMinDimension());
+  ASSERT_TRUE(style.hasMaxDimension());
+  // Degenerate aspect ratios are stored as undefined
+  ASSERT_FALSE(style.hasAspectRatio());
+  ASSERT_EQ(4.0f, style.computeMarginForAxis(FlexDirection::Row, 100.0f));
+  ASSERT_EQ(20.0f, style.computeMarginForAxis(FlexDirection::Column, 100.0f));
+
+  // The family stays set until its last value is unset
+  style.setMargin(Edge::Left, StyleLength::undefined());
+  ASSERT_TRUE(style.hasMargin());
+  style.setMargin(Edge::Vertical, StyleLength::undefined());
+  ASSERT_FALSE(style.hasMargin());
+  style.setMaxDimension(Dimension::Height, StyleSizeLength::undefined());
+  ASSERT_FALSE(style.hasMaxDimension());
+  ASSERT_EQ(style, yoga::Style{});
+}
+
+TEST(Style, resolved_edges_follow_setters) {
+  yoga::Style style;
+  style.setMargin(Edge::All, StyleLength::points(1.0f));
+  style.setMargin(Edge::Start, StyleLength::points(2.0f));
+  style.setMargin(Edge::Right, StyleLength::points(3.0f));
+
+  const auto row = FlexDirection::Row;
+  ASSERT_EQ(2.0f, style.computeInlineStartMargin(row, Direction::LTR, 0.0f));
+  ASSERT_EQ(3.0f, style.computeInlineEndMargin(row, Direction::LTR, 0.0f));
+  ASSERT_EQ(2.0f, style.computeInlineStartMargin(row, Direction::RTL, 0.0f));
+  ASSERT_EQ(1.0f, style.computeInlineEndMargin(row, Direction::RTL, 0.0f));
+  ASSERT_EQ(
+      1.0f,
+      style.computeInlineStartMargin(
+          FlexDirection::Column, Direction::LTR, 0.0f));
+
+  // Unsetting an edge falls back to the next edge in the chain, and values
+  // moving in the pool are picked up
+  style.setMargin(Edge::Start, StyleLength::undefined());
+  style.setMargin(Edge::All, StyleLength::percent(50.0f));
+  ASSERT_EQ(50.0f, style.computeInlineStartMargin(row, Direction::LTR, 100.0f));
+  ASSERT_EQ(50.0f, style.computeInlineEndMargin(row, Direction::RTL, 100.0f));
+  ASSERT_EQ(3.0f, style.computeInlineEndMargin(row, Direction::LTR, 100.0f));
+}
+
 } // namespace facebook::yoga
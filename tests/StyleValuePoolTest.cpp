@@ -143,4 +143,42 @@ TEST(StyleValuePool, store_keywords) {
   EXPECT_EQ(pool.getSize(handleStretch), StyleSizeLength::ofStretch());
 }
 
+TEST(StyleValuePool, store_keywords_after_large_ints) {
+  StyleValuePool pool;
+  StyleValueHandle handle1;
+  StyleValueHandle handle2;
+
+  pool.store(handle1, StyleSizeLength::points(10.5));
+  pool.store(handle2, StyleSizeLength::points(20.5));
+  pool.store(handle1, StyleSizeLength::ofFitContent());
+  pool.store(handle2, StyleSizeLength::ofMaxContent());
+
+  EXPECT_EQ(pool.getSize(handle1), StyleSizeLength::ofFitContent());
+  EXPECT_EQ(pool.getSize(handle2), StyleSizeLength::ofMaxContent());
+  EXPECT_EQ(pool.size(), 0);
+}
+
+TEST(StyleValuePool, store_churn_reuses_slots) {
+  StyleValuePool pool;
+  StyleValueHandle width;
+  StyleValueHandle height;
+  StyleValueHandle flexGrow;
+
+  pool.store(height, StyleSizeLength::points(100.25));
+  for (int i = 0; i < 10000; i++) {
+    const float value = static_cast<float>(i) / 4.0f;
+    pool.store(width, StyleSizeLength::points(value));
+    pool.store(flexGrow, FloatOptional{value});
+    if (i % 3 == 1) {
+      pool.store(width, StyleSizeLength::ofStretch());
+      pool.store(flexGrow, FloatOptional{});
+    }
+  }
+
+  EXPECT_EQ(pool.getSize(width), StyleSizeLength::points(2499.75));
+  EXPECT_EQ(pool.getSize(height), StyleSizeLength::points(100.25));
+  EXPECT_EQ(pool.getNumber(flexGrow), FloatOptional{2499.75});
+  EXPECT_LE(pool.size(), 3);
+}
+
 } // namespace facebook::yoga
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+#include <yoga/node/Node.h>
+
+using namespace facebook;
+
+static size_t absoluteDescendantCount(YGNodeConstRef node) {
+  return yoga::resolveRef(node)->getAbsoluteDescendantCount();
+}
+
+static YGNodeRef newStaticNode(YGConfigRef config) {
+  YGNodeRef node = YGNodeNewWithConfig(config);
+  YGNodeStyleSetPositionType(node, YGPositionTypeStatic);
+  return node;
+}
+
+static YGNodeRef newAbsoluteNode(YGConfigRef config) {
+  YGNodeRef node = YGNodeNewWithConfig(config);
+  YGNodeStyleSetPositionType(node, YGPositionTypeAbsolute);
+  YGNodeStyleSetPosition(node, YGEdgeLeft, 5);
+  YGNodeStyleSetPosition(node, YGEdgeTop, 7);
+  YGNodeStyleSetWidthPercent(node, 50);
+  YGNodeStyleSetHeight(node, 10);
+  return node;
+}
+
+TEST(YogaTest, absolute_descendants_counted_through_static_nodes) {
+  YGConfigRef config = YGConfigNew();
+
+  YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+
+  YGNodeRef root_child0 = newStaticNode(config);
+  YGNodeStyleSetHeight(root_child0, 50);
+  YGNodeInsertChild(root, root_child0, 0);
+
+  YGNodeRef root_child0_child0 = newStaticNode(config);
+  YGNodeInsertChild(root_child0, root_child0_child0, 0);
+
+  YGNodeRef root_child0_child0_child0 = newAbsoluteNode(config);
+  YGNodeInsertChild(root_child0_child0, root_child0_child0_child0, 0);
+
+  YGNodeRef root_child1 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root_child1, 40);
+  YGNodeStyleSetHeight(root_child1, 20);
+  YGNodeInsertChild(root, root_child1, 1);
+
+  YGNodeRef root_child1_child0 = newAbsoluteNode(config);
+  YGNodeInsertChild(root_child1, root_child1_child0, 0);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // The relative child forms its own containing block, so only the absolute
+  // node under the static chain belongs to the root
+  ASSERT_EQ(1, absoluteDescendantCount(root));
+  ASSERT_EQ(1, absoluteDescendantCount(root_child0));
+  ASSERT_EQ(1, absoluteDescendantCount(root_child0_child0));
+  ASSERT_EQ(1, absoluteDescendantCount(root_child1));
+  ASSERT_EQ(0, absoluteDescendantCount(root_child1_child0));
+
+  ASSERT_FLOAT_EQ(5, YGNodeLayoutGetLeft(root_child0_child0_child0));
+  ASSERT_FLOAT_EQ(7, YGNodeLayoutGetTop(root_child0_child0_child0));
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetWidth(root_child0_child0_child0));
+
+  ASSERT_FLOAT_EQ(5, YGNodeLayoutGetLeft(root_child1_child0));
+  ASSERT_FLOAT_EQ(7, YGNodeLayoutGetTop(root_child1_child0));
+  ASSERT_FLOAT_EQ(20, YGNodeLayoutGetWidth(root_child1_child0));
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, absolute_descendants_updated_on_tree_and_style_changes) {
+  YGConfigRef config = YGConfigNew();
+
+  YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+
+  YGNodeRef root_child0 = newStaticNode(config);
+  YGNodeStyleSetHeight(root_child0, 50);
+  YGNodeInsertChild(root, root_child0, 0);
+
+  YGNodeRef root_child0_child0 = newStaticNode(config);
+  YGNodeInsertChild(root_child0, root_child0_child0, 0);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(0, absoluteDescendantCount(root));
+
+  YGNodeRef absolute = newAbsoluteNode(config);
+  YGNodeInsertChild(root_child0_child0, absolute, 0);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(1, absoluteDescendantCount(root));
+  ASSERT_FLOAT_EQ(5, YGNodeLayoutGetLeft(absolute));
+  ASSERT_FLOAT_EQ(7, YGNodeLayoutGetTop(absolute));
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetWidth(absolute));
+
+  // Making the intermediate node a containing block takes the absolute node
+  // away from the root
+  YGNodeSetAlwaysFormsContainingBlock(root_child0, true);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(0, absoluteDescendantCount(root));
+  ASSERT_EQ(1, absoluteDescendantCount(root_child0));
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetWidth(absolute));
+
+  YGNodeSetAlwaysFormsContainingBlock(root_child0, false);
+  YGNodeStyleSetDisplay(root_child0_child0, YGDisplayNone);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(0, absoluteDescendantCount(root));
+  ASSERT_FLOAT_EQ(0, YGNodeLayoutGetWidth(absolute));
+
+  YGNodeStyleSetDisplay(root_child0_child0, YGDisplayFlex);
+  YGNodeStyleSetPositionType(absolute, YGPositionTypeRelative);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(0, absoluteDescendantCount(root));
+
+  YGNodeStyleSetPositionType(absolute, YGPositionTypeAbsolute);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(1, absoluteDescendantCount(root));
+  ASSERT_FLOAT_EQ(5, YGNodeLayoutGetLeft(absolute));
+  ASSERT_FLOAT_EQ(50, YGNodeLayoutGetWidth(absolute));
+
+  YGNodeRemoveChild(root_child0_child0, absolute);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(0, absoluteDescendantCount(root));
+  ASSERT_EQ(0, absoluteDescendantCount(root_child0));
+
+  YGNodeFree(absolute);
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
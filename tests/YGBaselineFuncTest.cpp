@@ -60,3 +60,59 @@ TEST(YogaTest, align_baseline_customer_func) {
   ASSERT_FLOAT_EQ(50, YGNodeLayoutGetWidth(root_child1_child0));
   ASSERT_FLOAT_EQ(20, YGNodeLayoutGetHeight(root_child1_child0));
 }
+
+static int baselineCallCount = 0;
+
+static float _countingBaseline(
+    YGNodeConstRef /*node*/,
+    const float /*width*/,
+    const float height) {
+  baselineCallCount++;
+  return height / 2;
+}
+
+TEST(YogaTest, align_baseline_func_called_once_per_layout_pass) {
+  baselineCallCount = 0;
+
+  YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetAlignItems(root, YGAlignBaseline);
+  YGNodeStyleSetWidth(root, 300);
+
+  YGNodeRef root_child0 = YGNodeNew();
+  YGNodeStyleSetFlexDirection(root_child0, YGFlexDirectionRow);
+  YGNodeStyleSetAlignItems(root_child0, YGAlignBaseline);
+  YGNodeInsertChild(root, root_child0, 0);
+
+  YGNodeRef root_child0_child0 = YGNodeNew();
+  YGNodeSetBaselineFunc(root_child0_child0, _countingBaseline);
+  YGNodeStyleSetWidth(root_child0_child0, 50);
+  YGNodeStyleSetHeight(root_child0_child0, 20);
+  YGNodeInsertChild(root_child0, root_child0_child0, 0);
+
+  YGNodeRef root_child0_child1 = YGNodeNew();
+  YGNodeStyleSetWidth(root_child0_child1, 50);
+  YGNodeStyleSetHeight(root_child0_child1, 40);
+  YGNodeInsertChild(root_child0, root_child0_child1, 1);
+
+  YGNodeRef root_child1 = YGNodeNew();
+  YGNodeSetBaselineFunc(root_child1, _countingBaseline);
+  YGNodeStyleSetWidth(root_child1, 50);
+  YGNodeStyleSetHeight(root_child1, 60);
+  YGNodeInsertChild(root, root_child1, 1);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_EQ(2, baselineCallCount);
+  ASSERT_FLOAT_EQ(0, YGNodeLayoutGetTop(root_child0));
+  ASSERT_FLOAT_EQ(30, YGNodeLayoutGetTop(root_child0_child0));
+  ASSERT_FLOAT_EQ(0, YGNodeLayoutGetTop(root_child0_child1));
+  ASSERT_FLOAT_EQ(10, YGNodeLayoutGetTop(root_child1));
+
+  // Baselines are recomputed in the next pass
+  YGNodeStyleSetWidth(root, 400);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(4, baselineCallCount);
+
+  YGNodeFreeRecursive(root);
+}
@@ -64,11 +64,13 @@ TEST(YogaTest, dirtied_propagation) {
   ASSERT_EQ(0, dirtiedCount);
 
   // `_dirtied` MUST be called for the first time.
-  static_cast<yoga::Node*>(root_child0)->markDirtyAndPropagate();
+  static_cast<yoga::Node*>(root_child0)->markDirtyAndPropagate(
+      yoga::DirtyReason::kNodeChange);
   ASSERT_EQ(1, dirtiedCount);
 
   // `_dirtied` must NOT be called for the second time.
-  static_cast<yoga::Node*>(root_child0)->markDirtyAndPropagate();
+  static_cast<yoga::Node*>(root_child0)->markDirtyAndPropagate(
+      yoga::DirtyReason::kNodeChange);
   ASSERT_EQ(1, dirtiedCount);
 }
 
@@ -97,14 +99,17 @@ TEST(YogaTest, dirtied_hierarchy) {
   ASSERT_EQ(0, dirtiedCount);
 
   // `_dirtied` must NOT be called for descendants.
-  static_cast<yoga::Node*>(root)->markDirtyAndPropagate();
+  static_cast<yoga::Node*>(root)->markDirtyAndPropagate(
+      yoga::DirtyReason::kNodeChange);
   ASSERT_EQ(0, dirtiedCount);
 
   // `_dirtied` must NOT be called for the sibling node.
-  static_cast<yoga::Node*>(root_child1)->markDirtyAndPropagate();
+  static_cast<yoga::Node*>(root_child1)->markDirtyAndPropagate(
+      yoga::DirtyReason::kNodeChange);
   ASSERT_EQ(0, dirtiedCount);
 
   // `_dirtied` MUST be called in case of explicit dirtying.
-  static_cast<yoga::Node*>(root_child0)->markDirtyAndPropagate();
+  static_cast<yoga::Node*>(root_child0)->markDirtyAndPropagate(
+      yoga::DirtyReason::kNodeChange);
   ASSERT_EQ(1, dirtiedCount);
 }
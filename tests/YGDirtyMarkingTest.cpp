@@ -249,3 +249,63 @@ TEST(YogaTest, dirty_node_only_if_undefined_values_gets_set_to_undefined) {
 
   YGNodeFreeRecursive(root);
 }
+
+TEST(YogaTest, dirty_propagation_only_if_change_affects_layout) {
+  YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+
+  YGNodeRef root_child0 = YGNodeNew();
+  YGNodeStyleSetHeight(root_child0, 20);
+  YGNodeInsertChild(root, root_child0, 0);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // Properties which only affect children don't matter to leaves
+  YGNodeStyleSetJustifyContent(root_child0, YGJustifyCenter);
+  YGNodeStyleSetAlignItems(root_child0, YGAlignFlexEnd);
+  YGNodeStyleSetFlexWrap(root_child0, YGWrapWrap);
+  YGNodeStyleSetGap(root_child0, YGGutterAll, 10);
+  YGNodeStyleSetOverflow(root_child0, YGOverflowScroll);
+  EXPECT_FALSE(YGNodeIsDirty(root_child0));
+  EXPECT_FALSE(YGNodeIsDirty(root));
+
+  // Hiding overflow doesn't change layout, scrolling does
+  YGNodeStyleSetOverflow(root, YGOverflowHidden);
+  EXPECT_FALSE(YGNodeIsDirty(root));
+  YGNodeStyleSetOverflow(root, YGOverflowScroll);
+  EXPECT_TRUE(YGNodeIsDirty(root));
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeStyleSetJustifyContent(root, YGJustifyCenter);
+  EXPECT_TRUE(YGNodeIsDirty(root));
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  EXPECT_FLOAT_EQ(40, YGNodeLayoutGetTop(root_child0));
+
+  // Adding a child to the leaf lays it out with the styles set earlier
+  YGNodeRef root_child0_child0 = YGNodeNew();
+  YGNodeStyleSetWidth(root_child0_child0, 10);
+  YGNodeStyleSetHeight(root_child0_child0, 10);
+  YGNodeInsertChild(root_child0, root_child0_child0, 0);
+  EXPECT_TRUE(YGNodeIsDirty(root));
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  YGNodeRef expected = YGNodeClone(root_child0);
+  YGNodeRef expected_child0 = YGNodeClone(root_child0_child0);
+  YGNodeRemoveAllChildren(expected);
+  YGNodeInsertChild(expected, expected_child0, 0);
+  YGNodeStyleSetWidth(expected, 100);
+  YGNodeCalculateLayout(expected, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  EXPECT_FLOAT_EQ(
+      YGNodeLayoutGetLeft(expected_child0),
+      YGNodeLayoutGetLeft(root_child0_child0));
+  EXPECT_FLOAT_EQ(
+      YGNodeLayoutGetTop(expected_child0),
+      YGNodeLayoutGetTop(root_child0_child0));
+
+  YGNodeFreeRecursive(expected);
+  YGNodeFreeRecursive(root);
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+
+#include <vector>
+
+struct CompletedLayout {
+  YGNodeConstRef node;
+  float left;
+  float top;
+  float width;
+  float height;
+};
+
+static std::vector<CompletedLayout> completedLayouts;
+
+static void _layoutComplete(YGNodeConstRef node) {
+  completedLayouts.push_back(
+      {node,
+       YGNodeLayoutGetLeft(node),
+       YGNodeLayoutGetTop(node),
+       YGNodeLayoutGetWidth(node),
+       YGNodeLayoutGetHeight(node)});
+}
+
+TEST(YogaTest, layout_complete_reports_each_node_with_rounded_layout) {
+  completedLayouts.clear();
+  YGConfigRef config = YGConfigNew();
+  YGConfigSetPointScaleFactor(config, 1);
+  YGConfigSetLayoutCompleteFunc(config, _layoutComplete);
+
+  YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+
+  YGNodeRef root_child0 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexGrow(root_child0, 1);
+  YGNodeInsertChild(root, root_child0, 0);
+
+  YGNodeRef root_child0_child0 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetHeight(root_child0_child0, 10.3f);
+  YGNodeInsertChild(root_child0, root_child0_child0, 0);
+
+  YGNodeRef root_child1 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexGrow(root_child1, 2);
+  YGNodeInsertChild(root, root_child1, 1);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  ASSERT_EQ(4, completedLayouts.size());
+  ASSERT_EQ(root, completedLayouts[0].node);
+  ASSERT_EQ(root_child0, completedLayouts[1].node);
+  ASSERT_EQ(root_child0_child0, completedLayouts[2].node);
+  ASSERT_EQ(root_child1, completedLayouts[3].node);
+
+  // Reported layouts are already final
+  for (const auto& completed : completedLayouts) {
+    ASSERT_FLOAT_EQ(YGNodeLayoutGetLeft(completed.node), completed.left);
+    ASSERT_FLOAT_EQ(YGNodeLayoutGetTop(completed.node), completed.top);
+    ASSERT_FLOAT_EQ(YGNodeLayoutGetWidth(completed.node), completed.width);
+    ASSERT_FLOAT_EQ(YGNodeLayoutGetHeight(completed.node), completed.height);
+  }
+  ASSERT_FLOAT_EQ(33, completedLayouts[1].width);
+  ASSERT_FLOAT_EQ(10, completedLayouts[2].height);
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, layout_complete_not_called_without_relayout) {
+  completedLayouts.clear();
+  YGConfigRef config = YGConfigNew();
+  YGConfigSetLayoutCompleteFunc(config, _layoutComplete);
+
+  YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(1, completedLayouts.size());
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(1, completedLayouts.size());
+
+  YGNodeStyleSetWidth(root, 200);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(2, completedLayouts.size());
+  ASSERT_FLOAT_EQ(200, completedLayouts[1].width);
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, layout_complete_skips_unchanged_and_hidden_nodes) {
+  completedLayouts.clear();
+  YGConfigRef config = YGConfigNew();
+  YGConfigSetLayoutCompleteFunc(config, _layoutComplete);
+
+  YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+
+  YGNodeRef root_child0 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root_child0, 10);
+  YGNodeInsertChild(root, root_child0, 0);
+
+  YGNodeRef root_child0_child0 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetHeight(root_child0_child0, 10);
+  YGNodeInsertChild(root_child0, root_child0_child0, 0);
+
+  YGNodeRef root_child1 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetDisplay(root_child1, YGDisplayNone);
+  YGNodeInsertChild(root, root_child1, 1);
+
+  YGNodeRef root_child1_child0 = YGNodeNewWithConfig(config);
+  YGNodeInsertChild(root_child1, root_child1_child0, 0);
+
+  YGNodeRef root_child2 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root_child2, 10);
+  YGNodeInsertChild(root, root_child2, 2);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(4, completedLayouts.size());
+  ASSERT_EQ(root, completedLayouts[0].node);
+  ASSERT_EQ(root_child0, completedLayouts[1].node);
+  ASSERT_EQ(root_child0_child0, completedLayouts[2].node);
+  ASSERT_EQ(root_child2, completedLayouts[3].node);
+
+  // The first child keeps its cached layout, so its subtree is not visited
+  // again
+  for (auto node : {root, root_child0, root_child0_child0, root_child2}) {
+    YGNodeSetHasNewLayout(node, false);
+  }
+  completedLayouts.clear();
+  YGNodeStyleSetWidth(root_child2, 20);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(3, completedLayouts.size());
+  ASSERT_EQ(root, completedLayouts[0].node);
+  ASSERT_EQ(root_child0, completedLayouts[1].node);
+  ASSERT_EQ(root_child2, completedLayouts[2].node);
+  ASSERT_FLOAT_EQ(20, completedLayouts[2].width);
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
+
+TEST(YogaTest, layout_complete_reports_nodes_moved_without_relayout) {
+  completedLayouts.clear();
+  YGConfigRef config = YGConfigNew();
+  YGConfigSetLayoutCompleteFunc(config, _layoutComplete);
+
+  YGNodeRef root = YGNodeNewWithConfig(config);
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+
+  YGNodeRef root_child0 = YGNodeNewWithConfig(config);
+  YGNodeStyleSetPositionType(root_child0, YGPositionTypeAbsolute);
+  YGNodeStyleSetPosition(root_child0, YGEdgeLeft, 0);
+  YGNodeStyleSetWidth(root_child0, 10);
+  YGNodeStyleSetHeight(root_child0, 10);
+  YGNodeInsertChild(root, root_child0, 0);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  completedLayouts.clear();
+
+  const YGStyleOp move = {
+      YGStylePropertyPosition, YGEdgeLeft, {30, YGUnitPoint}};
+  ASSERT_EQ(
+      YGStyleChangeLayoutUnaffected, YGNodeStyleAnimate(root_child0, move));
+  ASSERT_EQ(1, completedLayouts.size());
+  ASSERT_EQ(root_child0, completedLayouts[0].node);
+  ASSERT_FLOAT_EQ(30, completedLayouts[0].left);
+
+  YGNodeFreeRecursive(root);
+  YGConfigFree(config);
+}
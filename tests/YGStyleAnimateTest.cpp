@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+
+static YGStyleOp positionOp(YGEdge edge, float value, YGUnit unit) {
+  return {YGStylePropertyPosition, edge, {value, unit}};
+}
+
+static void assertSameLayout(YGNodeConstRef expected, YGNodeConstRef actual) {
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetLeft(expected), YGNodeLayoutGetLeft(actual));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetTop(expected), YGNodeLayoutGetTop(actual));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetRight(expected), YGNodeLayoutGetRight(actual));
+  ASSERT_FLOAT_EQ(
+      YGNodeLayoutGetBottom(expected), YGNodeLayoutGetBottom(actual));
+  ASSERT_FLOAT_EQ(YGNodeLayoutGetWidth(expected), YGNodeLayoutGetWidth(actual));
+  ASSERT_FLOAT_EQ(
+      YGNodeLayoutGetHeight(expected), YGNodeLayoutGetHeight(actual));
+}
+
+static YGNodeRef
+createTree(YGFlexDirection flexDirection, YGPositionType positionType) {
+  YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetFlexDirection(root, flexDirection);
+  YGNodeStyleSetPadding(root, YGEdgeAll, 10);
+  YGNodeStyleSetWidth(root, 200);
+  YGNodeStyleSetHeight(root, 200);
+
+  YGNodeRef sibling = YGNodeNew();
+  YGNodeStyleSetWidth(sibling, 30);
+  YGNodeStyleSetHeight(sibling, 30);
+  YGNodeInsertChild(root, sibling, 0);
+
+  YGNodeRef child = YGNodeNew();
+  YGNodeStyleSetPositionType(child, positionType);
+  YGNodeStyleSetWidth(child, 50);
+  YGNodeStyleSetHeight(child, 40);
+  YGNodeStyleSetMargin(child, YGEdgeStart, 5);
+  YGNodeStyleSetPosition(child, YGEdgeStart, 0);
+  YGNodeStyleSetPosition(child, YGEdgeTop, 0);
+  YGNodeInsertChild(root, child, 1);
+
+  YGNodeRef grandchild = YGNodeNew();
+  YGNodeStyleSetWidth(grandchild, 10);
+  YGNodeStyleSetHeight(grandchild, 10);
+  YGNodeInsertChild(child, grandchild, 0);
+  return root;
+}
+
+static void assertAnimatesLikeRelayout(
+    YGFlexDirection flexDirection,
+    YGPositionType positionType,
+    YGDirection direction) {
+  YGNodeRef animated = createTree(flexDirection, positionType);
+  YGNodeRef relaid = createTree(flexDirection, positionType);
+  YGNodeCalculateLayout(animated, YGUndefined, YGUndefined, direction);
+
+  const YGStyleOp frames[] = {
+      positionOp(YGEdgeStart, 12, YGUnitPoint),
+      positionOp(YGEdgeTop, 7, YGUnitPoint),
+      positionOp(YGEdgeStart, 20, YGUnitPoint),
+      positionOp(YGEdgeTop, -3, YGUnitPoint),
+  };
+  for (const auto& frame : frames) {
+    YGNodeRef child = YGNodeGetChild(animated, 1);
+    YGNodeSetHasNewLayout(animated, false);
+    YGNodeSetHasNewLayout(YGNodeGetChild(animated, 0), false);
+    YGNodeSetHasNewLayout(child, false);
+    ASSERT_EQ(YGStyleChangeLayoutUnaffected, YGNodeStyleAnimate(child, frame));
+    ASSERT_FALSE(YGNodeIsDirty(animated));
+    ASSERT_TRUE(YGNodeGetHasNewLayout(child));
+    ASSERT_TRUE(YGNodeGetHasNewLayout(animated));
+    ASSERT_FALSE(YGNodeGetHasNewLayout(YGNodeGetChild(animated, 0)));
+
+    YGNodeStyleApply(YGNodeGetChild(relaid, 1), &frame, 1);
+    YGNodeCalculateLayout(relaid, YGUndefined, YGUndefined, direction);
+    assertSameLayout(YGNodeGetChild(relaid, 1), child);
+    assertSameLayout(
+        YGNodeGetChild(YGNodeGetChild(relaid, 1), 0), YGNodeGetChild(child, 0));
+  }
+
+  YGNodeFreeRecursive(animated);
+  YGNodeFreeRecursive(relaid);
+}
+
+TEST(YogaTest, animate_absolute_inset_moves_node_without_relayout) {
+  assertAnimatesLikeRelayout(
+      YGFlexDirectionRow, YGPositionTypeAbsolute, YGDirectionLTR);
+  assertAnimatesLikeRelayout(
+      YGFlexDirectionColumnReverse, YGPositionTypeAbsolute, YGDirectionRTL);
+}
+
+TEST(YogaTest, animate_relative_inset_moves_node_without_relayout) {
+  assertAnimatesLikeRelayout(
+      YGFlexDirectionRowReverse, YGPositionTypeRelative, YGDirectionLTR);
+  assertAnimatesLikeRelayout(
+      YGFlexDirectionColumn, YGPositionTypeRelative, YGDirectionRTL);
+}
+
+TEST(YogaTest, animate_falls_back_to_relayout) {
+  YGNodeRef root = createTree(YGFlexDirectionRow, YGPositionTypeAbsolute);
+  YGNodeRef child = YGNodeGetChild(root, 1);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // Percentages depend on the size of the containing block
+  ASSERT_EQ(
+      YGStyleChangeLayout,
+      YGNodeStyleAnimate(child, positionOp(YGEdgeStart, 10, YGUnitPercent)));
+  ASSERT_TRUE(YGNodeIsDirty(root));
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(25, YGNodeLayoutGetLeft(child));
+
+  // Setting the value it already has changes nothing
+  ASSERT_EQ(
+      YGStyleChangeNone,
+      YGNodeStyleAnimate(child, positionOp(YGEdgeStart, 10, YGUnitPercent)));
+
+  // Insets on both sides of a node without a width stretch it between them
+  YGNodeStyleSetWidthAuto(child);
+  YGNodeStyleSetPosition(child, YGEdgeStart, 0);
+  YGNodeStyleSetPosition(child, YGEdgeEnd, 0);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_EQ(
+      YGStyleChangeLayout,
+      YGNodeStyleAnimate(child, positionOp(YGEdgeEnd, 20, YGUnitPoint)));
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(175, YGNodeLayoutGetWidth(child));
+
+  // Properties other than insets are applied as usual
+  YGStyleOp width = {YGStylePropertyWidth, 0, {20, YGUnitPoint}};
+  ASSERT_EQ(YGStyleChangeLayout, YGNodeStyleAnimate(child, width));
+  ASSERT_TRUE(YGNodeIsDirty(root));
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, animate_top_falls_back_under_baseline_alignment) {
+  YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+  YGNodeStyleSetAlignItems(root, YGAlignBaseline);
+
+  YGNodeRef container = YGNodeNew();
+  YGNodeInsertChild(root, container, 0);
+
+  YGNodeRef child = YGNodeNew();
+  YGNodeStyleSetPositionType(child, YGPositionTypeRelative);
+  YGNodeStyleSetWidth(child, 20);
+  YGNodeStyleSetHeight(child, 20);
+  YGNodeInsertChild(container, child, 0);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  // Moving the child across moves nothing else
+  ASSERT_EQ(
+      YGStyleChangeLayoutUnaffected,
+      YGNodeStyleAnimate(child, positionOp(YGEdgeLeft, 5, YGUnitPoint)));
+
+  // Moving it down moves the baseline of its container
+  ASSERT_EQ(
+      YGStyleChangeLayout,
+      YGNodeStyleAnimate(child, positionOp(YGEdgeTop, 5, YGUnitPoint)));
+  ASSERT_TRUE(YGNodeIsDirty(root));
+
+  YGNodeFreeRecursive(root);
+}
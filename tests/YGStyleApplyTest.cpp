@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+
+static YGStyleOp op(YGStyleProperty property, float value) {
+  return {property, 0, {value, YGUnitPoint}};
+}
+
+static YGStyleOp enumOp(YGStyleProperty property, int value) {
+  return {property, 0, {static_cast<float>(value), YGUnitUndefined}};
+}
+
+static YGStyleOp
+lengthOp(YGStyleProperty property, int index, float value, YGUnit unit) {
+  return {property, index, {value, unit}};
+}
+
+TEST(YogaTest, style_apply_matches_individual_setters) {
+  YGNodeRef applied = YGNodeNew();
+  const YGStyleOp ops[] = {
+      enumOp(YGStylePropertyFlexDirection, YGFlexDirectionRow),
+      enumOp(YGStylePropertyJustifyContent, YGJustifySpaceBetween),
+      enumOp(YGStylePropertyAlignItems, YGAlignCenter),
+      enumOp(YGStylePropertyPositionType, YGPositionTypeAbsolute),
+      enumOp(YGStylePropertyDisplay, YGDisplayContents),
+      op(YGStylePropertyFlexGrow, 2),
+      lengthOp(YGStylePropertyFlexBasis, 0, 0, YGUnitFitContent),
+      lengthOp(YGStylePropertyMargin, YGEdgeLeft, 0, YGUnitAuto),
+      lengthOp(YGStylePropertyPadding, YGEdgeAll, 10, YGUnitPercent),
+      lengthOp(YGStylePropertyBorder, YGEdgeTop, 3, YGUnitPoint),
+      lengthOp(YGStylePropertyPosition, YGEdgeEnd, 5, YGUnitPoint),
+      lengthOp(YGStylePropertyGap, YGGutterRow, 4, YGUnitPoint),
+      lengthOp(YGStylePropertyWidth, 0, 50, YGUnitPercent),
+      lengthOp(YGStylePropertyHeight, 0, 0, YGUnitStretch),
+      lengthOp(YGStylePropertyMaxWidth, 0, 200, YGUnitPoint),
+      op(YGStylePropertyAspectRatio, 1.5f),
+  };
+  YGNodeStyleApply(applied, ops, sizeof(ops) / sizeof(ops[0]));
+
+  YGNodeRef set = YGNodeNew();
+  YGNodeStyleSetFlexDirection(set, YGFlexDirectionRow);
+  YGNodeStyleSetJustifyContent(set, YGJustifySpaceBetween);
+  YGNodeStyleSetAlignItems(set, YGAlignCenter);
+  YGNodeStyleSetPositionType(set, YGPositionTypeAbsolute);
+  YGNodeStyleSetDisplay(set, YGDisplayContents);
+  YGNodeStyleSetFlexGrow(set, 2);
+  YGNodeStyleSetFlexBasisFitContent(set);
+  YGNodeStyleSetMarginAuto(set, YGEdgeLeft);
+  YGNodeStyleSetPaddingPercent(set, YGEdgeAll, 10);
+  YGNodeStyleSetBorder(set, YGEdgeTop, 3);
+  YGNodeStyleSetPosition(set, YGEdgeEnd, 5);
+  YGNodeStyleSetGap(set, YGGutterRow, 4);
+  YGNodeStyleSetWidthPercent(set, 50);
+  YGNodeStyleSetHeightStretch(set);
+  YGNodeStyleSetMaxWidth(set, 200);
+  YGNodeStyleSetAspectRatio(set, 1.5f);
+
+  YGNodeRef copied = YGNodeNew();
+  YGNodeCopyStyle(copied, applied);
+  YGNodeCopyStyle(copied, set);
+  // Copying the style of "set" over an equal style leaves the node clean
+  YGNodeCalculateLayout(copied, YGUndefined, YGUndefined, YGDirectionLTR);
+  YGNodeCopyStyle(copied, applied);
+  ASSERT_FALSE(YGNodeIsDirty(copied));
+
+  ASSERT_EQ(YGFlexDirectionRow, YGNodeStyleGetFlexDirection(applied));
+  ASSERT_EQ(YGDisplayContents, YGNodeStyleGetDisplay(applied));
+  ASSERT_EQ(YGUnitFitContent, YGNodeStyleGetFlexBasis(applied).unit);
+  ASSERT_EQ(YGUnitAuto, YGNodeStyleGetMargin(applied, YGEdgeLeft).unit);
+  ASSERT_FLOAT_EQ(3, YGNodeStyleGetBorder(applied, YGEdgeTop));
+  ASSERT_FLOAT_EQ(1.5f, YGNodeStyleGetAspectRatio(applied));
+  ASSERT_EQ(YGNodeStyleGetFingerprint(set), YGNodeStyleGetFingerprint(applied));
+
+  YGNodeFree(applied);
+  YGNodeFree(set);
+  YGNodeFree(copied);
+}
+
+TEST(YogaTest, style_apply_dirties_only_on_change) {
+  YGNodeRef root = YGNodeNew();
+  YGNodeRef child = YGNodeNew();
+  YGNodeStyleSetWidth(child, 10);
+  YGNodeStyleSetFlexGrow(child, 1);
+  YGNodeInsertChild(root, child, 0);
+
+  YGNodeCalculateLayout(root, 100, 100, YGDirectionLTR);
+  ASSERT_FALSE(YGNodeIsDirty(root));
+
+  const YGStyleOp unchanged[] = {
+      lengthOp(YGStylePropertyWidth, 0, 10, YGUnitPoint),
+      op(YGStylePropertyFlexGrow, 1),
+  };
+  YGNodeStyleApply(child, unchanged, 2);
+  ASSERT_FALSE(YGNodeIsDirty(child));
+  ASSERT_FALSE(YGNodeIsDirty(root));
+
+  const YGStyleOp changed[] = {
+      lengthOp(YGStylePropertyWidth, 0, 10, YGUnitPoint),
+      op(YGStylePropertyFlexGrow, 0),
+      lengthOp(YGStylePropertyHeight, 0, 30, YGUnitPoint),
+  };
+  YGNodeStyleApply(child, changed, 3);
+  ASSERT_TRUE(YGNodeIsDirty(child));
+  ASSERT_TRUE(YGNodeIsDirty(root));
+
+  YGNodeCalculateLayout(root, 100, 100, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(30, YGNodeLayoutGetHeight(child));
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, style_diff_reports_layout_impact) {
+  YGNodeRef root = YGNodeNew();
+  YGNodeRef child = YGNodeNew();
+  YGNodeStyleSetWidth(child, 10);
+  YGNodeInsertChild(root, child, 0);
+  YGNodeCalculateLayout(root, 100, 100, YGDirectionLTR);
+
+  const YGStyleOp same[] = {
+      lengthOp(YGStylePropertyWidth, 0, 10, YGUnitPoint),
+  };
+  ASSERT_EQ(YGStyleChangeNone, YGNodeStyleDiff(child, same, 1));
+
+  const YGStyleOp leafOnly[] = {
+      enumOp(YGStylePropertyJustifyContent, YGJustifyCenter),
+      enumOp(YGStylePropertyOverflow, YGOverflowHidden),
+  };
+  ASSERT_EQ(
+      YGStyleChangeLayoutUnaffected, YGNodeStyleDiff(child, leafOnly, 2));
+  ASSERT_EQ(YGStyleChangeLayout, YGNodeStyleDiff(root, leafOnly, 2));
+
+  const YGStyleOp resize[] = {
+      enumOp(YGStylePropertyJustifyContent, YGJustifyCenter),
+      lengthOp(YGStylePropertyWidth, 0, 20, YGUnitPoint),
+  };
+  ASSERT_EQ(YGStyleChangeLayout, YGNodeStyleDiff(child, resize, 2));
+
+  // Diffing leaves the style untouched
+  ASSERT_EQ(YGJustifyFlexStart, YGNodeStyleGetJustifyContent(child));
+  ASSERT_FLOAT_EQ(10, YGNodeStyleGetWidth(child).value);
+
+  ASSERT_EQ(
+      YGStyleChangeLayoutUnaffected, YGNodeStyleApply(child, leafOnly, 2));
+  ASSERT_EQ(YGJustifyCenter, YGNodeStyleGetJustifyContent(child));
+  ASSERT_FALSE(YGNodeIsDirty(root));
+
+  ASSERT_EQ(YGStyleChangeLayout, YGNodeStyleApply(child, resize, 2));
+  ASSERT_TRUE(YGNodeIsDirty(root));
+
+  YGNodeFreeRecursive(root);
+}
+
+#if GTEST_HAS_DEATH_TEST
+TEST(YogaDeathTest, style_apply_rejects_out_of_range_enums_and_indices) {
+  YGNodeRef node = YGNodeNew();
+  const YGStyleOp badEnum = enumOp(YGStylePropertyAlignItems, 42);
+  const YGStyleOp badEdge =
+      lengthOp(YGStylePropertyMargin, YGEdgeAll + 1, 10, YGUnitPoint);
+#if defined(__cpp_exceptions)
+  ASSERT_THROW(YGNodeStyleApply(node, &badEnum, 1), std::logic_error);
+  ASSERT_THROW(YGNodeStyleApply(node, &badEdge, 1), std::logic_error);
+#else // !defined(__cpp_exceptions)
+  ASSERT_DEATH(YGNodeStyleApply(node, &badEnum, 1), "Style op value.*");
+  ASSERT_DEATH(YGNodeStyleApply(node, &badEdge, 1), "Style op index.*");
+#endif // defined(__cpp_exceptions)
+  YGNodeFree(node);
+}
+#endif
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+
+static std::vector<uint8_t> serialize(YGNodeConstRef node) {
+  std::vector<uint8_t> buffer(YGNodeStyleSerialize(node, nullptr, 0));
+  EXPECT_EQ(
+      buffer.size(), YGNodeStyleSerialize(node, buffer.data(), buffer.size()));
+  return buffer;
+}
+
+TEST(YogaTest, style_serialization_round_trips) {
+  YGNodeRef node = YGNodeNew();
+  YGNodeStyleSetFlexDirection(node, YGFlexDirectionRowReverse);
+  YGNodeStyleSetAlignItems(node, YGAlignBaseline);
+  YGNodeStyleSetDisplay(node, YGDisplayContents);
+  YGNodeStyleSetBoxSizing(node, YGBoxSizingContentBox);
+  YGNodeStyleSetFlexGrow(node, 2);
+  YGNodeStyleSetFlexShrink(node, 0.5f);
+  YGNodeStyleSetFlexBasisPercent(node, 33.3f);
+  YGNodeStyleSetMarginAuto(node, YGEdgeStart);
+  YGNodeStyleSetPosition(node, YGEdgeTop, -12.25f);
+  YGNodeStyleSetPadding(node, YGEdgeHorizontal, 8);
+  YGNodeStyleSetBorder(node, YGEdgeAll, 1);
+  YGNodeStyleSetGap(node, YGGutterRow, 100000);
+  YGNodeStyleSetWidthMaxContent(node);
+  YGNodeStyleSetMinHeightPercent(node, 10);
+  YGNodeStyleSetMaxHeight(node, 640);
+  YGNodeStyleSetAspectRatio(node, 1.5f);
+
+  const auto buffer = serialize(node);
+  YGNodeRef copy = YGNodeNew();
+  ASSERT_TRUE(YGNodeStyleDeserialize(copy, buffer.data(), buffer.size()));
+  ASSERT_EQ(YGNodeStyleGetFingerprint(node), YGNodeStyleGetFingerprint(copy));
+  ASSERT_EQ(serialize(node), serialize(copy));
+
+  ASSERT_EQ(YGFlexDirectionRowReverse, YGNodeStyleGetFlexDirection(copy));
+  ASSERT_EQ(YGAlignBaseline, YGNodeStyleGetAlignItems(copy));
+  ASSERT_EQ(YGDisplayContents, YGNodeStyleGetDisplay(copy));
+  ASSERT_EQ(YGBoxSizingContentBox, YGNodeStyleGetBoxSizing(copy));
+  ASSERT_FLOAT_EQ(2, YGNodeStyleGetFlexGrow(copy));
+  ASSERT_FLOAT_EQ(0.5f, YGNodeStyleGetFlexShrink(copy));
+  ASSERT_TRUE(YGNodeStyleGetFlexBasis(node) == YGNodeStyleGetFlexBasis(copy));
+  ASSERT_EQ(YGUnitAuto, YGNodeStyleGetMargin(copy, YGEdgeStart).unit);
+  ASSERT_FLOAT_EQ(-12.25f, YGNodeStyleGetPosition(copy, YGEdgeTop).value);
+  ASSERT_FLOAT_EQ(8, YGNodeStyleGetPadding(copy, YGEdgeHorizontal).value);
+  ASSERT_FLOAT_EQ(1, YGNodeStyleGetBorder(copy, YGEdgeAll));
+  ASSERT_FLOAT_EQ(100000, YGNodeStyleGetGap(copy, YGGutterRow).value);
+  ASSERT_EQ(YGUnitMaxContent, YGNodeStyleGetWidth(copy).unit);
+  ASSERT_TRUE(YGNodeStyleGetMinHeight(node) == YGNodeStyleGetMinHeight(copy));
+  ASSERT_FLOAT_EQ(640, YGNodeStyleGetMaxHeight(copy).value);
+  ASSERT_FLOAT_EQ(1.5f, YGNodeStyleGetAspectRatio(copy));
+
+  // Edges are resolved for layout
+  YGNodeCalculateLayout(copy, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(8, YGNodeLayoutGetPadding(copy, YGEdgeLeft));
+  ASSERT_FLOAT_EQ(1, YGNodeLayoutGetBorder(copy, YGEdgeBottom));
+
+  YGNodeFree(node);
+  YGNodeFree(copy);
+}
+
+TEST(YogaTest, style_serialization_is_compact) {
+  YGNodeRef node = YGNodeNew();
+  const size_t defaultSize = YGNodeStyleSerialize(node, nullptr, 0);
+  ASSERT_EQ(13u, defaultSize);
+
+  // Values which fit in their handle take two bytes, others take four more
+  YGNodeStyleSetWidth(node, 100);
+  ASSERT_EQ(defaultSize + 2, YGNodeStyleSerialize(node, nullptr, 0));
+  YGNodeStyleSetHeight(node, 10.5f);
+  ASSERT_EQ(defaultSize + 8, YGNodeStyleSerialize(node, nullptr, 0));
+
+  // Nothing is written to a buffer which is too small
+  std::vector<uint8_t> buffer(defaultSize, 0xff);
+  ASSERT_EQ(
+      defaultSize + 8,
+      YGNodeStyleSerialize(node, buffer.data(), buffer.size()));
+  ASSERT_EQ(std::vector<uint8_t>(defaultSize, 0xff), buffer);
+
+  YGNodeFree(node);
+}
+
+TEST(YogaTest, style_deserialization_dirties_only_on_change) {
+  YGNodeRef root = YGNodeNew();
+  YGNodeRef child = YGNodeNew();
+  YGNodeStyleSetHeight(child, 20);
+  YGNodeInsertChild(root, child, 0);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  auto buffer = serialize(child);
+  ASSERT_TRUE(YGNodeStyleDeserialize(child, buffer.data(), buffer.size()));
+  ASSERT_FALSE(YGNodeIsDirty(root));
+
+  YGNodeRef other = YGNodeNew();
+  YGNodeStyleSetHeight(other, 30);
+  buffer = serialize(other);
+  ASSERT_TRUE(YGNodeStyleDeserialize(child, buffer.data(), buffer.size()));
+  ASSERT_TRUE(YGNodeIsDirty(root));
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(30, YGNodeLayoutGetHeight(child));
+
+  YGNodeFree(other);
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, style_deserialization_rejects_malformed_input) {
+  YGNodeRef node = YGNodeNew();
+  YGNodeStyleSetWidth(node, 10.5f);
+  const auto valid = serialize(node);
+
+  YGNodeRef target = YGNodeNew();
+  const auto rejects = [&](std::vector<uint8_t> buffer) {
+    return !YGNodeStyleDeserialize(target, buffer.data(), buffer.size()) &&
+        YGNodeStyleGetFingerprint(target) == 0;
+  };
+
+  ASSERT_TRUE(rejects({}));
+  ASSERT_TRUE(rejects({valid.begin(), valid.end() - 1}));
+  ASSERT_TRUE(rejects({valid.begin(), valid.end() - 4}));
+
+  auto version = valid;
+  version[0] = 2;
+  ASSERT_TRUE(rejects(version));
+
+  // Align takes four bits, but has fewer than sixteen values
+  auto alignContent = valid;
+  alignContent[1] |= 0x80;
+  alignContent[2] |= 0x07;
+  ASSERT_TRUE(rejects(alignContent));
+
+  // Width can not be a plain number, which is the fourth type of handle
+  auto width = valid;
+  width[13] = static_cast<uint8_t>((width[13] & 0xf8) | 3);
+  ASSERT_TRUE(rejects(width));
+
+  // Only one value follows the handles
+  auto index = valid;
+  index[13] |= 0x10;
+  ASSERT_TRUE(rejects(index));
+
+  ASSERT_TRUE(YGNodeStyleDeserialize(target, valid.data(), valid.size()));
+  ASSERT_FLOAT_EQ(10.5f, YGNodeStyleGetWidth(target).value);
+
+  YGNodeFree(node);
+  YGNodeFree(target);
+}
+
+// Moves the only value handle in an encoding to another position in the
+// mask, so that it sets another property
+static void moveHandle(std::vector<uint8_t>& buffer, size_t to) {
+  std::fill(buffer.begin() + 5, buffer.begin() + 13, 0);
+  buffer[5 + to / 8] = static_cast<uint8_t>(1 << (to % 8));
+}
+
+TEST(YogaTest, style_deserialization_rejects_units_setters_never_produce) {
+  // Positions of the handles of the All edge and gutter, and of min width
+  constexpr size_t positionAll = 21;
+  constexpr size_t paddingAll = 30;
+  constexpr size_t borderAll = 39;
+  constexpr size_t gapAll = 42;
+  constexpr size_t minWidth = 45;
+
+  YGNodeRef target = YGNodeNew();
+  const auto accepts = [&](std::vector<uint8_t> buffer) {
+    return YGNodeStyleDeserialize(target, buffer.data(), buffer.size());
+  };
+
+  YGNodeRef percent = YGNodeNew();
+  YGNodeStyleSetPaddingPercent(percent, YGEdgeAll, 10);
+  auto percentBorder = serialize(percent);
+  moveHandle(percentBorder, borderAll);
+  ASSERT_FALSE(accepts(percentBorder));
+
+  YGNodeRef autoMargin = YGNodeNew();
+  YGNodeStyleSetMarginAuto(autoMargin, YGEdgeAll);
+  for (const auto to : {paddingAll, borderAll, gapAll, minWidth}) {
+    auto buffer = serialize(autoMargin);
+    moveHandle(buffer, to);
+    ASSERT_FALSE(accepts(buffer));
+  }
+  ASSERT_EQ(0u, YGNodeStyleGetFingerprint(target));
+
+  auto autoPosition = serialize(autoMargin);
+  moveHandle(autoPosition, positionAll);
+  ASSERT_TRUE(accepts(autoPosition));
+  ASSERT_EQ(YGUnitAuto, YGNodeStyleGetPosition(target, YGEdgeAll).unit);
+
+  YGNodeFree(percent);
+  YGNodeFree(autoMargin);
+  YGNodeFree(target);
+}
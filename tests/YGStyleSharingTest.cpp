@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+#include <yoga/node/Node.h>
+
+using namespace facebook;
+
+static bool sharesStyle(YGNodeConstRef a, YGNodeConstRef b) {
+  return yoga::resolveRef(a)->sharesStyleWith(*yoga::resolveRef(b));
+}
+
+TEST(YogaTest, new_nodes_share_default_style) {
+  YGConfigRef config = YGConfigNew();
+  YGConfigRef webConfig = YGConfigNew();
+  YGConfigSetUseWebDefaults(webConfig, true);
+
+  YGNodeRef a = YGNodeNewWithConfig(config);
+  YGNodeRef b = YGNodeNewWithConfig(config);
+  YGNodeRef web = YGNodeNewWithConfig(webConfig);
+
+  ASSERT_TRUE(sharesStyle(a, b));
+  ASSERT_FALSE(sharesStyle(a, web));
+  ASSERT_EQ(YGFlexDirectionColumn, YGNodeStyleGetFlexDirection(a));
+  ASSERT_EQ(YGFlexDirectionRow, YGNodeStyleGetFlexDirection(web));
+
+  YGNodeStyleSetWidth(a, 10);
+  ASSERT_FALSE(sharesStyle(a, b));
+  ASSERT_FLOAT_EQ(10, YGNodeStyleGetWidth(a).value);
+  ASSERT_EQ(YGUnitAuto, YGNodeStyleGetWidth(b).unit);
+
+  YGNodeFree(a);
+  YGNodeFree(b);
+  YGNodeFree(web);
+  YGConfigFree(config);
+  YGConfigFree(webConfig);
+}
+
+TEST(YogaTest, style_detached_only_when_changed) {
+  YGNodeRef node = YGNodeNew();
+  YGNodeStyleSetWidth(node, 100);
+  YGNodeStyleSetMargin(node, YGEdgeLeft, 5);
+
+  YGNodeRef clone = YGNodeClone(node);
+  ASSERT_TRUE(sharesStyle(node, clone));
+
+  // Setting a value the style already has keeps it shared
+  YGNodeStyleSetWidth(clone, 100);
+  YGNodeStyleSetMargin(clone, YGEdgeLeft, 5);
+  ASSERT_TRUE(sharesStyle(node, clone));
+
+  YGNodeStyleSetMargin(clone, YGEdgeLeft, 6);
+  ASSERT_FALSE(sharesStyle(node, clone));
+  ASSERT_FLOAT_EQ(5, YGNodeStyleGetMargin(node, YGEdgeLeft).value);
+  ASSERT_FLOAT_EQ(6, YGNodeStyleGetMargin(clone, YGEdgeLeft).value);
+  ASSERT_FLOAT_EQ(100, YGNodeStyleGetWidth(clone).value);
+
+  YGNodeFree(node);
+  YGNodeFree(clone);
+}
+
+TEST(YogaTest, copy_style_shares_style) {
+  YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetWidth(root, 100);
+  YGNodeStyleSetHeight(root, 100);
+
+  YGNodeRef child = YGNodeNew();
+  YGNodeInsertChild(root, child, 0);
+
+  YGNodeRef source = YGNodeNew();
+  YGNodeStyleSetHeight(source, 20);
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FALSE(YGNodeIsDirty(root));
+
+  YGNodeCopyStyle(child, source);
+  ASSERT_TRUE(sharesStyle(child, source));
+  ASSERT_TRUE(YGNodeIsDirty(root));
+
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(20, YGNodeLayoutGetHeight(child));
+
+  // Copying an equal style shares it without invalidating layout
+  YGNodeRef equal = YGNodeNew();
+  YGNodeStyleSetHeight(equal, 20);
+  YGNodeCopyStyle(child, equal);
+  ASSERT_TRUE(sharesStyle(child, equal));
+  ASSERT_FALSE(YGNodeIsDirty(root));
+
+  YGNodeStyleSetHeight(source, 30);
+  ASSERT_FALSE(YGNodeIsDirty(root));
+  ASSERT_FLOAT_EQ(20, YGNodeStyleGetHeight(child).value);
+
+  YGNodeFreeRecursive(root);
+  YGNodeFree(source);
+  YGNodeFree(equal);
+}
+
+TEST(YogaTest, moved_from_node_keeps_its_style) {
+  yoga::Node node;
+  node.mutableStyle().setFlexGrow(yoga::FloatOptional{2});
+
+  yoga::Node moved{std::move(node)};
+  ASSERT_TRUE(moved.sharesStyleWith(node));
+  ASSERT_FLOAT_EQ(2, node.style().flexGrow().unwrap());
+
+  node.mutableStyle().setFlexGrow(yoga::FloatOptional{3});
+  ASSERT_FALSE(moved.sharesStyleWith(node));
+  ASSERT_FLOAT_EQ(2, moved.style().flexGrow().unwrap());
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <yoga/Yoga.h>
+
+static YGStyleOp
+lengthOp(YGStyleProperty property, int index, float value, YGUnit unit) {
+  return {property, index, {value, unit}};
+}
+
+TEST(YogaTest, style_template_shared_by_attached_nodes) {
+  const YGStyleOp ops[] = {
+      lengthOp(YGStylePropertyHeight, 0, 20, YGUnitPoint),
+      lengthOp(YGStylePropertyMargin, YGEdgeBottom, 4, YGUnitPoint),
+  };
+  YGStyleTemplateRef item = YGStyleTemplateNew(YGConfigGetDefault(), ops, 2);
+
+  YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetWidth(root, 100);
+  for (size_t i = 0; i < 3; i++) {
+    YGNodeRef child = YGNodeNew();
+    YGNodeSetStyleTemplate(child, item);
+    YGNodeInsertChild(root, child, i);
+  }
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(72, YGNodeLayoutGetHeight(root));
+
+  // Attaching the template to a node already using it changes nothing
+  YGNodeRef first = YGNodeGetChild(root, 0);
+  YGNodeSetStyleTemplate(first, item);
+  ASSERT_FALSE(YGNodeIsDirty(root));
+
+  // Overrides only apply to the node they are set on
+  YGNodeRef last = YGNodeGetChild(root, 2);
+  YGNodeStyleSetHeight(last, 30);
+  ASSERT_FALSE(YGNodeUsesStyleTemplate(last, item));
+  ASSERT_TRUE(YGNodeUsesStyleTemplate(first, item));
+  ASSERT_FLOAT_EQ(20, YGNodeStyleGetHeight(first).value);
+  ASSERT_FLOAT_EQ(4, YGNodeStyleGetMargin(last, YGEdgeBottom).value);
+
+  // Nodes keep their style once the template is freed
+  YGStyleTemplateFree(item);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(82, YGNodeLayoutGetHeight(root));
+  ASSERT_FLOAT_EQ(20, YGNodeLayoutGetHeight(first));
+
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, style_template_dirties_only_on_change) {
+  YGNodeRef root = YGNodeNew();
+  YGNodeRef child = YGNodeNew();
+  YGNodeStyleSetHeight(child, 20);
+  YGNodeInsertChild(root, child, 0);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+
+  YGStyleTemplateRef same = YGStyleTemplateNewFromNode(child);
+  YGNodeRef other = YGNodeNew();
+  YGNodeSetStyleTemplate(other, same);
+  YGNodeSetStyleTemplate(child, same);
+  ASSERT_TRUE(YGNodeUsesStyleTemplate(child, same));
+  ASSERT_FALSE(YGNodeIsDirty(root));
+
+  const YGStyleOp taller = lengthOp(YGStylePropertyHeight, 0, 30, YGUnitPoint);
+  YGStyleTemplateRef changed =
+      YGStyleTemplateNew(YGConfigGetDefault(), &taller, 1);
+  YGNodeSetStyleTemplate(child, changed);
+  ASSERT_TRUE(YGNodeIsDirty(root));
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+  ASSERT_FLOAT_EQ(30, YGNodeLayoutGetHeight(child));
+
+  // Setting a template's own values on a node still detaches nothing
+  YGNodeStyleSetHeight(child, 30);
+  ASSERT_TRUE(YGNodeUsesStyleTemplate(child, changed));
+
+  YGStyleTemplateFree(same);
+  YGStyleTemplateFree(changed);
+  YGNodeFree(other);
+  YGNodeFreeRecursive(root);
+}
+
+TEST(YogaTest, style_template_starts_from_config_defaults) {
+  YGConfigRef config = YGConfigNew();
+  YGConfigSetUseWebDefaults(config, true);
+
+  YGStyleTemplateRef web = YGStyleTemplateNew(config, nullptr, 0);
+  YGNodeRef node = YGNodeNewWithConfig(config);
+  YGNodeSetStyleTemplate(node, web);
+  ASSERT_EQ(YGFlexDirectionRow, YGNodeStyleGetFlexDirection(node));
+  ASSERT_EQ(YGAlignStretch, YGNodeStyleGetAlignContent(node));
+
+  YGStyleTemplateFree(web);
+  YGNodeFree(node);
+  YGConfigFree(config);
+}
@@ -9,6 +9,7 @@
 
 #include <yoga/YGEnums.h>
 #include <yoga/YGNode.h>
+#include <yoga/YGNodeStyle.h>
 #include <yoga/event/event.h>
 #include <yoga/node/Node.h>
 #include <iostream>
@@ -41,7 +42,9 @@ void yogaEventSubscriber(
 
 void TestUtil::startCountingNodes() {
   nodeInstanceCount = 0;
-  Event::subscribe(yogaEventSubscriber);
+  Event::subscribe(
+      yogaEventSubscriber,
+      Event::typeMask<Event::NodeAllocation, Event::NodeDeallocation>());
 }
 
 int TestUtil::nodeCount() {
@@ -56,8 +59,9 @@ int TestUtil::stopCountingNodes() {
 }
 
 ScopedEventSubscription::ScopedEventSubscription(
-    std::function<Event::Subscriber>&& s) {
-  Event::subscribe(std::move(s));
+    std::function<Event::Subscriber>&& s,
+    Event::TypeMask types) {
+  Event::subscribe(std::move(s), types);
 }
 
 ScopedEventSubscription::~ScopedEventSubscription() {
@@ -161,4 +165,23 @@ float calculateHeight(
   return (currentLineLength == 0 ? lines - 1 : lines) * heightPerChar;
 }
 
+YGSize measureFixedSize(
+    YGNodeConstRef /*node*/,
+    float /*width*/,
+    YGMeasureMode /*widthMode*/,
+    float /*height*/,
+    YGMeasureMode /*heightMode*/) {
+  return YGSize{40, 10};
+}
+
+YGNodeRef createMeasuredRow(YGMeasureFunc measureFunc) {
+  YGNodeRef root = YGNodeNew();
+  YGNodeStyleSetFlexDirection(root, YGFlexDirectionRow);
+
+  YGNodeRef leaf = YGNodeNew();
+  YGNodeSetMeasureFunc(leaf, measureFunc);
+  YGNodeInsertChild(root, leaf, 0);
+  return root;
+}
+
 } // namespace facebook::yoga::test
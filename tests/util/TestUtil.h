@@ -21,7 +21,9 @@ struct TestUtil {
 };
 
 struct ScopedEventSubscription {
-  explicit ScopedEventSubscription(std::function<Event::Subscriber>&&);
+  explicit ScopedEventSubscription(
+      std::function<Event::Subscriber>&&,
+      Event::TypeMask types = Event::allTypes);
   ~ScopedEventSubscription();
 };
 
@@ -40,4 +42,15 @@ float calculateHeight(
     float widthPerChar,
     float heightPerChar);
 
+// Measures a leaf as 40 by 10 points, whatever the space available
+YGSize measureFixedSize(
+    YGNodeConstRef node,
+    float width,
+    YGMeasureMode widthMode,
+    float height,
+    YGMeasureMode heightMode);
+
+// A row around a single leaf, measured by the given function
+YGNodeRef createMeasuredRow(YGMeasureFunc measureFunc = measureFixedSize);
+
 } // namespace facebook::yoga::test
@@ -90,3 +90,9 @@ void YGConfigSetCloneNodeFunc(
     const YGCloneNodeFunc callback) {
   resolveRef(config)->setCloneNodeCallback(callback);
 }
+
+void YGConfigSetLayoutCompleteFunc(
+    const YGConfigRef config,
+    const YGLayoutCompleteFunc callback) {
+  resolveRef(config)->setLayoutCompleteCallback(callback);
+}
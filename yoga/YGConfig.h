@@ -155,4 +155,27 @@ YG_EXPORT void YGConfigSetCloneNodeFunc(
     YGConfigRef config,
     YGCloneNodeFunc callback);
 
+/**
+ * Function pointer type for YGConfigSetLayoutCompleteFunc.
+ */
+typedef void (*YGLayoutCompleteFunc)(YGNodeConstRef node);
+
+/**
+ * Sets a callback, called for each node whose layout changed, once its final
+ * (pixel grid rounded) layout is known. YGNodeCalculateLayout() calls it during
+ * its final pass, which rounds the tree to the pixel grid after the whole tree
+ * was laid out, reporting each node before its children. Hosts may read new
+ * frames from it instead of traversing the tree again afterwards.
+ *
+ * Only displayed nodes flagged as having a new layout (see
+ * YGNodeGetHasNewLayout()) are reported. A node moved by YGNodeStyleAnimate()
+ * without a layout pass is reported right away.
+ *
+ * The callback is read from the config of each node. It is not called if the
+ * layout of the tree did not need to be recalculated.
+ */
+YG_EXPORT void YGConfigSetLayoutCompleteFunc(
+    YGConfigRef config,
+    YGLayoutCompleteFunc callback);
+
 YG_EXTERN_C_END
@@ -126,6 +126,42 @@ YG_ENUM_DECL(
     YGPositionTypeRelative,
     YGPositionTypeAbsolute)
 
+YG_ENUM_DECL(
+    YGStyleChange,
+    YGStyleChangeNone,
+    YGStyleChangeLayoutUnaffected,
+    YGStyleChangeLayout)
+
+YG_ENUM_DECL(
+    YGStyleProperty,
+    YGStylePropertyDirection,
+    YGStylePropertyFlexDirection,
+    YGStylePropertyJustifyContent,
+    YGStylePropertyAlignContent,
+    YGStylePropertyAlignItems,
+    YGStylePropertyAlignSelf,
+    YGStylePropertyPositionType,
+    YGStylePropertyFlexWrap,
+    YGStylePropertyOverflow,
+    YGStylePropertyDisplay,
+    YGStylePropertyBoxSizing,
+    YGStylePropertyFlex,
+    YGStylePropertyFlexGrow,
+    YGStylePropertyFlexShrink,
+    YGStylePropertyFlexBasis,
+    YGStylePropertyPosition,
+    YGStylePropertyMargin,
+    YGStylePropertyPadding,
+    YGStylePropertyBorder,
+    YGStylePropertyGap,
+    YGStylePropertyAspectRatio,
+    YGStylePropertyWidth,
+    YGStylePropertyHeight,
+    YGStylePropertyMinWidth,
+    YGStylePropertyMinHeight,
+    YGStylePropertyMaxWidth,
+    YGStylePropertyMaxHeight)
+
 YG_ENUM_DECL(
     YGUnit,
     YGUnitUndefined,
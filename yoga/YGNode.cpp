@@ -114,7 +114,7 @@ void YGNodeMarkDirty(const YGNodeRef nodeRef) {
       "Only leaf nodes with custom measure functions "
       "should manually mark themselves as dirty");
 
-  node->markDirtyAndPropagate();
+  node->markDirtyAndPropagate(DirtyReason::kMeasureDirty);
 }
 
 void YGNodeSetDirtiedFunc(YGNodeRef node, YGDirtiedFunc dirtiedFunc) {
@@ -144,7 +144,7 @@ void YGNodeInsertChild(
 
   owner->insertChild(child, index);
   child->setOwner(owner);
-  owner->markDirtyAndPropagate();
+  owner->markDirtyAndPropagate(DirtyReason::kChildInsert);
 }
 
 void YGNodeSwapChild(
@@ -178,7 +178,7 @@ void YGNodeRemoveChild(
       excludedChild->setLayout({}); // layout is no longer valid
       excludedChild->setOwner(nullptr);
     }
-    owner->markDirtyAndPropagate();
+    owner->markDirtyAndPropagate(DirtyReason::kChildRemove);
   }
 }
 
@@ -200,13 +200,13 @@ void YGNodeRemoveAllChildren(const YGNodeRef ownerRef) {
       oldChild->setOwner(nullptr);
     }
     owner->clearChildren();
-    owner->markDirtyAndPropagate();
+    owner->markDirtyAndPropagate(DirtyReason::kChildrenChange);
     return;
   }
   // Otherwise, we are not the owner of the child set. We don't have to do
   // anything to clear it.
   owner->setChildren({});
-  owner->markDirtyAndPropagate();
+  owner->markDirtyAndPropagate(DirtyReason::kChildrenChange);
 }
 
 void YGNodeSetChildren(
@@ -228,7 +228,7 @@ void YGNodeSetChildren(
         child->setOwner(nullptr);
       }
       owner->setChildren({});
-      owner->markDirtyAndPropagate();
+      owner->markDirtyAndPropagate(DirtyReason::kChildrenChange);
     }
   } else {
     if (owner->getChildCount() > 0) {
@@ -246,7 +246,7 @@ void YGNodeSetChildren(
     for (yoga::Node* child : childrenVector) {
       child->setOwner(owner);
     }
-    owner->markDirtyAndPropagate();
+    owner->markDirtyAndPropagate(DirtyReason::kChildrenChange);
   }
 }
 
@@ -307,7 +307,7 @@ void YGNodeSetIsReferenceBaseline(YGNodeRef nodeRef, bool isReferenceBaseline) {
   const auto node = resolveRef(nodeRef);
   if (node->isReferenceBaseline() != isReferenceBaseline) {
     node->setIsReferenceBaseline(isReferenceBaseline);
-    node->markDirtyAndPropagate();
+    node->markDirtyAndPropagate(DirtyReason::kNodeChange);
   }
 }
 
@@ -326,7 +326,11 @@ YGNodeType YGNodeGetNodeType(YGNodeConstRef node) {
 void YGNodeSetAlwaysFormsContainingBlock(
     YGNodeRef node,
     bool alwaysFormsContainingBlock) {
-  resolveRef(node)->setAlwaysFormsContainingBlock(alwaysFormsContainingBlock);
+  auto* n = resolveRef(node);
+  if (n->alwaysFormsContainingBlock() != alwaysFormsContainingBlock) {
+    n->setAlwaysFormsContainingBlock(alwaysFormsContainingBlock);
+    n->markDirtyAndPropagate(DirtyReason::kNodeChange);
+  }
 }
 
 bool YGNodeGetAlwaysFormsContainingBlock(YGNodeConstRef node) {
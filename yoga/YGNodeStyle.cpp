@@ -5,31 +5,321 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
+#include <type_traits>
+
 #include <yoga/Yoga.h>
+#include <yoga/algorithm/Reposition.h>
 #include <yoga/debug/AssertFatal.h>
+#include <yoga/enums/StyleChange.h>
 #include <yoga/node/Node.h>
+#include <yoga/style/StyleTemplate.h>
 
 using namespace facebook;
 using namespace facebook::yoga;
 
 namespace {
 
-template <auto GetterT, auto SetterT, typename ValueT>
+// The nodes whose layout a style property is read for
+enum class PropertyScope {
+  // The node itself, and through it its relatives
+  Node,
+  // Only the children of the node, when laying them out
+  Children,
+};
+
+template <PropertyScope ScopeT, typename ValueT>
+StyleChange
+classifyStyleChange(const yoga::Node* node, ValueT oldValue, ValueT newValue) {
+  if (oldValue == newValue) {
+    return StyleChange::None;
+  }
+  if constexpr (ScopeT == PropertyScope::Children) {
+    if (node->getChildCount() == 0) {
+      return StyleChange::LayoutUnaffected;
+    }
+  }
+  if constexpr (std::is_same_v<ValueT, Overflow>) {
+    // Layout only distinguishes scrolling containers from the rest
+    if (oldValue != Overflow::Scroll && newValue != Overflow::Scroll) {
+      return StyleChange::LayoutUnaffected;
+    }
+  }
+  return StyleChange::Layout;
+}
+
+template <auto GetterT, PropertyScope ScopeT, typename ValueT>
+StyleChange diffStyle(const yoga::Node* node, ValueT value) {
+  return classifyStyleChange<ScopeT>(node, (node->style().*GetterT)(), value);
+}
+
+template <auto GetterT, PropertyScope ScopeT, typename IdxT, typename ValueT>
+StyleChange diffStyle(const yoga::Node* node, IdxT idx, ValueT value) {
+  return classifyStyleChange<ScopeT>(
+      node, (node->style().*GetterT)(idx), value);
+}
+
+// Stores the value, without invalidating layout
+template <auto GetterT, auto SetterT, PropertyScope ScopeT, typename ValueT>
+StyleChange setStyle(yoga::Node* node, ValueT value) {
+  const auto change = diffStyle<GetterT, ScopeT>(node, value);
+  if (change != StyleChange::None) {
+    (node->mutableStyle().*SetterT)(value);
+  }
+  return change;
+}
+
+template <
+    auto GetterT,
+    auto SetterT,
+    PropertyScope ScopeT,
+    typename IdxT,
+    typename ValueT>
+StyleChange setStyle(yoga::Node* node, IdxT idx, ValueT value) {
+  const auto change = diffStyle<GetterT, ScopeT>(node, idx, value);
+  if (change != StyleChange::None) {
+    (node->mutableStyle().*SetterT)(idx, value);
+  }
+  return change;
+}
+
+template <
+    auto GetterT,
+    auto SetterT,
+    PropertyScope ScopeT = PropertyScope::Node,
+    typename ValueT>
 void updateStyle(YGNodeRef node, ValueT value) {
-  auto& style = resolveRef(node)->style();
-  if ((style.*GetterT)() != value) {
-    (style.*SetterT)(value);
-    resolveRef(node)->markDirtyAndPropagate();
+  auto* n = resolveRef(node);
+  if (setStyle<GetterT, SetterT, ScopeT>(n, value) == StyleChange::Layout) {
+    n->markDirtyAndPropagate(DirtyReason::kStyleChange);
   }
 }
 
-template <auto GetterT, auto SetterT, typename IdxT, typename ValueT>
+template <
+    auto GetterT,
+    auto SetterT,
+    PropertyScope ScopeT = PropertyScope::Node,
+    typename IdxT,
+    typename ValueT>
 void updateStyle(YGNodeRef node, IdxT idx, ValueT value) {
-  auto& style = resolveRef(node)->style();
-  if ((style.*GetterT)(idx) != value) {
-    (style.*SetterT)(idx, value);
-    resolveRef(node)->markDirtyAndPropagate();
+  auto* n = resolveRef(node);
+  if (setStyle<GetterT, SetterT, ScopeT>(n, idx, value) ==
+      StyleChange::Layout) {
+    n->markDirtyAndPropagate(DirtyReason::kStyleChange);
+  }
+}
+
+template <typename EnumT>
+auto enumValue(const YGStyleOp& op) {
+  using ScopedEnumT = decltype(scopedEnum(EnumT{}));
+  // Also rejects NaN, before the value is converted
+  yoga::assertFatal(
+      op.value.value >= 0 &&
+          op.value.value < static_cast<float>(ordinalCount<ScopedEnumT>()),
+      "Style op value is not a valid enum constant");
+  return scopedEnum(static_cast<EnumT>(static_cast<int>(op.value.value)));
+}
+
+template <typename EnumT>
+auto indexValue(const YGStyleOp& op) {
+  using ScopedEnumT = decltype(scopedEnum(EnumT{}));
+  yoga::assertFatal(
+      op.index >= 0 && op.index < ordinalCount<ScopedEnumT>(),
+      "Style op index is not a valid edge or gutter");
+  return scopedEnum(static_cast<EnumT>(op.index));
+}
+
+StyleLength lengthValue(
+    const YGStyleOp& op,
+    bool allowPercent = true,
+    bool allowAuto = true) {
+  switch (op.value.unit) {
+    case YGUnitUndefined:
+      return StyleLength::undefined();
+    case YGUnitPoint:
+      return StyleLength::points(op.value.value);
+    case YGUnitPercent:
+      if (allowPercent) {
+        return StyleLength::percent(op.value.value);
+      }
+      break;
+    case YGUnitAuto:
+      if (allowAuto) {
+        return StyleLength::ofAuto();
+      }
+      break;
+    default:
+      break;
+  }
+  fatalWithMessage("Unit not supported by style property");
+}
+
+StyleSizeLength sizeLengthValue(const YGStyleOp& op, bool allowAuto = true) {
+  switch (op.value.unit) {
+    case YGUnitUndefined:
+      return StyleSizeLength::undefined();
+    case YGUnitPoint:
+      return StyleSizeLength::points(op.value.value);
+    case YGUnitPercent:
+      return StyleSizeLength::percent(op.value.value);
+    case YGUnitAuto:
+      if (allowAuto) {
+        return StyleSizeLength::ofAuto();
+      }
+      break;
+    case YGUnitMaxContent:
+      return StyleSizeLength::ofMaxContent();
+    case YGUnitFitContent:
+      return StyleSizeLength::ofFitContent();
+    case YGUnitStretch:
+      return StyleSizeLength::ofStretch();
+  }
+  fatalWithMessage("Unit not supported by style property");
+}
+
+template <
+    auto GetterT,
+    auto SetterT,
+    PropertyScope ScopeT = PropertyScope::Node>
+struct StyleAccessor {
+  static constexpr auto getter = GetterT;
+  static constexpr auto setter = SetterT;
+  static constexpr auto scope = ScopeT;
+};
+
+// Calls fn with the StyleAccessor of the property updated by the op, followed
+// by the index if any, and the new value
+template <typename FnT>
+auto visitStyleOp(const YGStyleOp& op, FnT&& fn) {
+  switch (op.property) {
+    case YGStylePropertyDirection:
+      return fn(
+          StyleAccessor<&Style::direction, &Style::setDirection>{},
+          enumValue<YGDirection>(op));
+    case YGStylePropertyFlexDirection:
+      return fn(
+          StyleAccessor<&Style::flexDirection, &Style::setFlexDirection>{},
+          enumValue<YGFlexDirection>(op));
+    case YGStylePropertyJustifyContent:
+      return fn(
+          StyleAccessor<
+              &Style::justifyContent,
+              &Style::setJustifyContent,
+              PropertyScope::Children>{},
+          enumValue<YGJustify>(op));
+    case YGStylePropertyAlignContent:
+      return fn(
+          StyleAccessor<
+              &Style::alignContent,
+              &Style::setAlignContent,
+              PropertyScope::Children>{},
+          enumValue<YGAlign>(op));
+    case YGStylePropertyAlignItems:
+      return fn(
+          StyleAccessor<
+              &Style::alignItems,
+              &Style::setAlignItems,
+              PropertyScope::Children>{},
+          enumValue<YGAlign>(op));
+    case YGStylePropertyAlignSelf:
+      return fn(
+          StyleAccessor<&Style::alignSelf, &Style::setAlignSelf>{},
+          enumValue<YGAlign>(op));
+    case YGStylePropertyPositionType:
+      return fn(
+          StyleAccessor<&Style::positionType, &Style::setPositionType>{},
+          enumValue<YGPositionType>(op));
+    case YGStylePropertyFlexWrap:
+      return fn(
+          StyleAccessor<
+              &Style::flexWrap,
+              &Style::setFlexWrap,
+              PropertyScope::Children>{},
+          enumValue<YGWrap>(op));
+    case YGStylePropertyOverflow:
+      return fn(
+          StyleAccessor<
+              &Style::overflow,
+              &Style::setOverflow,
+              PropertyScope::Children>{},
+          enumValue<YGOverflow>(op));
+    case YGStylePropertyDisplay:
+      return fn(
+          StyleAccessor<&Style::display, &Style::setDisplay>{},
+          enumValue<YGDisplay>(op));
+    case YGStylePropertyBoxSizing:
+      return fn(
+          StyleAccessor<&Style::boxSizing, &Style::setBoxSizing>{},
+          enumValue<YGBoxSizing>(op));
+    case YGStylePropertyFlex:
+      return fn(
+          StyleAccessor<&Style::flex, &Style::setFlex>{},
+          FloatOptional{op.value.value});
+    case YGStylePropertyFlexGrow:
+      return fn(
+          StyleAccessor<&Style::flexGrow, &Style::setFlexGrow>{},
+          FloatOptional{op.value.value});
+    case YGStylePropertyFlexShrink:
+      return fn(
+          StyleAccessor<&Style::flexShrink, &Style::setFlexShrink>{},
+          FloatOptional{op.value.value});
+    case YGStylePropertyFlexBasis:
+      return fn(
+          StyleAccessor<&Style::flexBasis, &Style::setFlexBasis>{},
+          sizeLengthValue(op));
+    case YGStylePropertyPosition:
+      return fn(
+          StyleAccessor<&Style::position, &Style::setPosition>{},
+          indexValue<YGEdge>(op), lengthValue(op));
+    case YGStylePropertyMargin:
+      return fn(
+          StyleAccessor<&Style::margin, &Style::setMargin>{},
+          indexValue<YGEdge>(op), lengthValue(op));
+    case YGStylePropertyPadding:
+      return fn(
+          StyleAccessor<&Style::padding, &Style::setPadding>{},
+          indexValue<YGEdge>(op),
+          lengthValue(op, /*allowPercent*/ true, /*allowAuto*/ false));
+    case YGStylePropertyBorder:
+      return fn(
+          StyleAccessor<&Style::border, &Style::setBorder>{},
+          indexValue<YGEdge>(op),
+          lengthValue(op, /*allowPercent*/ false, /*allowAuto*/ false));
+    case YGStylePropertyGap:
+      return fn(
+          StyleAccessor<&Style::gap, &Style::setGap, PropertyScope::Children>{},
+          indexValue<YGGutter>(op),
+          lengthValue(op, /*allowPercent*/ true, /*allowAuto*/ false));
+    case YGStylePropertyAspectRatio:
+      return fn(
+          StyleAccessor<&Style::aspectRatio, &Style::setAspectRatio>{},
+          FloatOptional{op.value.value});
+    case YGStylePropertyWidth:
+      return fn(
+          StyleAccessor<&Style::dimension, &Style::setDimension>{},
+          Dimension::Width, sizeLengthValue(op));
+    case YGStylePropertyHeight:
+      return fn(
+          StyleAccessor<&Style::dimension, &Style::setDimension>{},
+          Dimension::Height, sizeLengthValue(op));
+    case YGStylePropertyMinWidth:
+      return fn(
+          StyleAccessor<&Style::minDimension, &Style::setMinDimension>{},
+          Dimension::Width, sizeLengthValue(op, /*allowAuto*/ false));
+    case YGStylePropertyMinHeight:
+      return fn(
+          StyleAccessor<&Style::minDimension, &Style::setMinDimension>{},
+          Dimension::Height, sizeLengthValue(op, /*allowAuto*/ false));
+    case YGStylePropertyMaxWidth:
+      return fn(
+          StyleAccessor<&Style::maxDimension, &Style::setMaxDimension>{},
+          Dimension::Width, sizeLengthValue(op, /*allowAuto*/ false));
+    case YGStylePropertyMaxHeight:
+      return fn(
+          StyleAccessor<&Style::maxDimension, &Style::setMaxDimension>{},
+          Dimension::Height, sizeLengthValue(op, /*allowAuto*/ false));
   }
+  fatalWithMessage("Invalid style property");
 }
 
 } // namespace
@@ -38,10 +328,143 @@ void YGNodeCopyStyle(YGNodeRef dstNode, YGNodeConstRef srcNode) {
   auto dst = resolveRef(dstNode);
   auto src = resolveRef(srcNode);
 
-  if (dst->style() != src->style()) {
-    dst->setStyle(src->style());
-    dst->markDirtyAndPropagate();
+  if (dst->sharesStyleWith(*src)) {
+    return;
+  }
+  const bool styleChanged = dst->style() != src->style();
+  dst->shareStyle(*src);
+  if (styleChanged) {
+    dst->markDirtyAndPropagate(DirtyReason::kStyleChange);
+  }
+}
+
+YGStyleTemplateRef YGStyleTemplateNew(
+    YGConfigConstRef config,
+    const YGStyleOp* ops,
+    size_t count) {
+  Style style = *yoga::Node::defaultStyle(*resolveRef(config));
+  const auto apply = [&](auto accessor, auto... args) {
+    using Accessor = decltype(accessor);
+    (style.*Accessor::setter)(args...);
+  };
+  for (size_t i = 0; i < count; i++) {
+    visitStyleOp(ops[i], apply);
+  }
+  return new yoga::StyleTemplate(std::move(style));
+}
+
+YGStyleTemplateRef YGStyleTemplateNewFromNode(YGNodeConstRef node) {
+  return new yoga::StyleTemplate(resolveRef(node)->style());
+}
+
+void YGStyleTemplateFree(YGStyleTemplateRef styleTemplate) {
+  delete resolveRef(styleTemplate);
+}
+
+void YGNodeSetStyleTemplate(
+    YGNodeRef node,
+    YGStyleTemplateConstRef styleTemplate) {
+  auto* n = resolveRef(node);
+  const auto& style = resolveRef(styleTemplate)->style();
+
+  if (n->sharesStyle(style)) {
+    return;
+  }
+  const bool styleChanged = n->style() != *style;
+  n->shareStyle(style);
+  if (styleChanged) {
+    n->markDirtyAndPropagate(DirtyReason::kStyleChange);
+  }
+}
+
+bool YGNodeUsesStyleTemplate(
+    YGNodeConstRef node,
+    YGStyleTemplateConstRef styleTemplate) {
+  return resolveRef(node)->sharesStyle(resolveRef(styleTemplate)->style());
+}
+
+size_t
+YGNodeStyleSerialize(YGNodeConstRef node, void* buffer, size_t bufferSize) {
+  return resolveRef(node)->style().serialize(
+      static_cast<uint8_t*>(buffer), bufferSize);
+}
+
+bool YGNodeStyleDeserialize(
+    YGNodeRef node,
+    const void* buffer,
+    size_t bufferSize) {
+  auto style =
+      Style::deserialize(static_cast<const uint8_t*>(buffer), bufferSize);
+  if (!style.has_value()) {
+    return false;
+  }
+
+  auto* n = resolveRef(node);
+  if (n->style() != *style) {
+    n->shareStyle(std::make_shared<Style>(std::move(*style)));
+    n->markDirtyAndPropagate(DirtyReason::kStyleChange);
+  }
+  return true;
+}
+
+uint64_t YGNodeStyleGetFingerprint(YGNodeConstRef node) {
+  return resolveRef(node)->style().fingerprint();
+}
+
+YGStyleChange
+YGNodeStyleApply(YGNodeRef node, const YGStyleOp* ops, size_t count) {
+  auto* n = resolveRef(node);
+  const auto apply = [&](auto accessor, auto... args) {
+    using Accessor = decltype(accessor);
+    return setStyle<Accessor::getter, Accessor::setter, Accessor::scope>(
+        n, args...);
+  };
+
+  auto change = StyleChange::None;
+  for (size_t i = 0; i < count; i++) {
+    change = std::max(change, visitStyleOp(ops[i], apply));
+  }
+  if (change == StyleChange::Layout) {
+    n->markDirtyAndPropagate(DirtyReason::kStyleChange);
+  }
+  return unscopedEnum(change);
+}
+
+YGStyleChange YGNodeStyleAnimate(YGNodeRef node, YGStyleOp op) {
+  if (op.property != YGStylePropertyPosition) {
+    return YGNodeStyleApply(node, &op, 1);
+  }
+
+  auto* n = resolveRef(node);
+  const auto from = computeInsetOffsets(n);
+  const auto change =
+      setStyle<&Style::position, &Style::setPosition, PropertyScope::Node>(
+          n, indexValue<YGEdge>(op), lengthValue(op));
+  if (change == StyleChange::None) {
+    return YGStyleChangeNone;
+  }
+
+  const auto to = computeInsetOffsets(n);
+  if (from.has_value() && to.has_value() && repositionNode(n, *from, *to)) {
+    return YGStyleChangeLayoutUnaffected;
+  }
+  n->markDirtyAndPropagate(DirtyReason::kStyleChange);
+  return YGStyleChangeLayout;
+}
+
+YGStyleChange
+YGNodeStyleDiff(YGNodeConstRef node, const YGStyleOp* ops, size_t count) {
+  const auto* n = resolveRef(node);
+  const auto diff = [&](auto accessor, auto... args) {
+    using Accessor = decltype(accessor);
+    return diffStyle<Accessor::getter, Accessor::scope>(n, args...);
+  };
+
+  auto change = StyleChange::None;
+  for (size_t i = 0; i < count; i++) {
+    change = std::max(change, visitStyleOp(ops[i], diff));
   }
+  return unscopedEnum(change);
 }
 
 void YGNodeStyleSetDirection(const YGNodeRef node, const YGDirection value) {
@@ -66,7 +489,10 @@ YGFlexDirection YGNodeStyleGetFlexDirection(const YGNodeConstRef node) {
 void YGNodeStyleSetJustifyContent(
     const YGNodeRef node,
     const YGJustify justifyContent) {
-  updateStyle<&Style::justifyContent, &Style::setJustifyContent>(
+  updateStyle<
+      &Style::justifyContent,
+      &Style::setJustifyContent,
+      PropertyScope::Children>(
       node, scopedEnum(justifyContent));
 }
 
@@ -77,7 +503,10 @@ YGJustify YGNodeStyleGetJustifyContent(const YGNodeConstRef node) {
 void YGNodeStyleSetAlignContent(
     const YGNodeRef node,
     const YGAlign alignContent) {
-  updateStyle<&Style::alignContent, &Style::setAlignContent>(
+  updateStyle<
+      &Style::alignContent,
+      &Style::setAlignContent,
+      PropertyScope::Children>(
       node, scopedEnum(alignContent));
 }
 
@@ -86,7 +515,10 @@ YGAlign YGNodeStyleGetAlignContent(const YGNodeConstRef node) {
 }
 
 void YGNodeStyleSetAlignItems(const YGNodeRef node, const YGAlign alignItems) {
-  updateStyle<&Style::alignItems, &Style::setAlignItems>(
+  updateStyle<
+      &Style::alignItems,
+      &Style::setAlignItems,
+      PropertyScope::Children>(
       node, scopedEnum(alignItems));
 }
 
@@ -115,7 +547,7 @@ YGPositionType YGNodeStyleGetPositionType(const YGNodeConstRef node) {
 }
 
 void YGNodeStyleSetFlexWrap(const YGNodeRef node, const YGWrap flexWrap) {
-  updateStyle<&Style::flexWrap, &Style::setFlexWrap>(
+  updateStyle<&Style::flexWrap, &Style::setFlexWrap, PropertyScope::Children>(
       node, scopedEnum(flexWrap));
 }
 
@@ -124,7 +556,7 @@ YGWrap YGNodeStyleGetFlexWrap(const YGNodeConstRef node) {
 }
 
 void YGNodeStyleSetOverflow(const YGNodeRef node, const YGOverflow overflow) {
-  updateStyle<&Style::overflow, &Style::setOverflow>(
+  updateStyle<&Style::overflow, &Style::setOverflow, PropertyScope::Children>(
       node, scopedEnum(overflow));
 }
 
@@ -284,12 +716,12 @@ void YGNodeStyleSetGap(
     const YGNodeRef node,
     const YGGutter gutter,
     const float gapLength) {
-  updateStyle<&Style::gap, &Style::setGap>(
+  updateStyle<&Style::gap, &Style::setGap, PropertyScope::Children>(
       node, scopedEnum(gutter), StyleLength::points(gapLength));
 }
 
 void YGNodeStyleSetGapPercent(YGNodeRef node, YGGutter gutter, float percent) {
-  updateStyle<&Style::gap, &Style::setGap>(
+  updateStyle<&Style::gap, &Style::setGap, PropertyScope::Children>(
       node, scopedEnum(gutter), StyleLength::percent(percent));
 }
 
@@ -7,7 +7,9 @@
 
 #pragma once
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include <yoga/YGNode.h>
 #include <yoga/YGValue.h>
@@ -16,6 +18,138 @@ YG_EXTERN_C_BEGIN
 
 YG_EXPORT void YGNodeCopyStyle(YGNodeRef dstNode, YGNodeConstRef srcNode);
 
+/**
+ * Handle to an immutable style which can be attached to many nodes.
+ */
+typedef struct YGStyleTemplate* YGStyleTemplateRef;
+typedef const struct YGStyleTemplate* YGStyleTemplateConstRef;
+
+/**
+ * A single style property update, for use with YGNodeStyleApply().
+ */
+typedef struct YGStyleOp {
+  YGStyleProperty property;
+  /**
+   * The YGEdge of a Position, Margin, Padding or Border update, or the
+   * YGGutter of a Gap update. Ignored by other properties.
+   */
+  int index;
+  /**
+   * Lengths use both the value and the unit, which may be any unit accepted
+   * by the setters of the property. Numbers only use the value. Enumerated
+   * properties store the enum constant in the value.
+   */
+  YGValue value;
+} YGStyleOp;
+
+/**
+ * Applies a list of style updates to the node, in order. Each update has the
+ * same effect as the corresponding YGNodeStyleSet* function, but the node is
+ * only marked dirty once, if any of them changed its layout. Returns the most
+ * invalidating change made by the updates.
+ */
+YG_EXPORT YGStyleChange
+YGNodeStyleApply(YGNodeRef node, const YGStyleOp* ops, size_t count);
+
+/**
+ * Returns how applying the list of style updates to the node would affect
+ * it, without applying them. Each update is compared against the current
+ * style of the node.
+ *
+ * Style changes only mark the node dirty when they may change layout, such as
+ * an update to a property which only matters to the children of a node that
+ * has none.
+ */
+YG_EXPORT YGStyleChange
+YGNodeStyleDiff(YGNodeConstRef node, const YGStyleOp* ops, size_t count);
+
+/**
+ * Applies a single style update to the node, like YGNodeStyleApply(), for
+ * properties which are changed on every frame of an animation.
+ *
+ * When an update to the insets of a node can only move the node itself, such
+ * as moving an absolutely positioned node with a fixed size, the layout of the
+ * node is moved right away without invalidating the layout of the tree, and
+ * YGStyleChangeLayoutUnaffected is returned. The node is flagged as having a
+ * new layout, but no layout pass runs for it. Other updates invalidate layout
+ * as usual.
+ */
+YG_EXPORT YGStyleChange YGNodeStyleAnimate(YGNodeRef node, YGStyleOp op);
+
+/**
+ * Creates a style template, starting from the default style of nodes created
+ * with the config and applying the list of style updates to it, as
+ * YGNodeStyleApply() would. The template cannot be changed once created.
+ */
+YG_EXPORT YGStyleTemplateRef YGStyleTemplateNew(
+    YGConfigConstRef config,
+    const YGStyleOp* ops,
+    size_t count);
+
+/**
+ * Creates a style template holding the current style of the node.
+ */
+YG_EXPORT YGStyleTemplateRef YGStyleTemplateNewFromNode(YGNodeConstRef node);
+
+/**
+ * Frees the template. Nodes it is attached to keep their style.
+ */
+YG_EXPORT void YGStyleTemplateFree(YGStyleTemplateRef styleTemplate);
+
+/**
+ * Replaces the style of the node with the style of the template, which is
+ * shared with the template rather than copied. The node is only marked dirty
+ * if its style changed.
+ *
+ * Setting a style property of the node afterwards overrides it for that node
+ * alone, which gives the node its own copy of the style.
+ */
+YG_EXPORT void YGNodeSetStyleTemplate(
+    YGNodeRef node,
+    YGStyleTemplateConstRef styleTemplate);
+
+/**
+ * Whether the node shares the style of the template, i.e. it was attached to
+ * the template and none of its style properties were overridden since.
+ */
+YG_EXPORT bool YGNodeUsesStyleTemplate(
+    YGNodeConstRef node,
+    YGStyleTemplateConstRef styleTemplate);
+
+/**
+ * Writes a compact, versioned binary encoding of the style of the node into
+ * the buffer, if bufferSize is large enough, and returns the size of the
+ * encoding. Passing a null buffer returns the size needed.
+ *
+ * The encoding does not depend on the node, its config, or the platform, so
+ * it may be stored or sent elsewhere and read back with
+ * YGNodeStyleDeserialize().
+ */
+YG_EXPORT size_t
+YGNodeStyleSerialize(YGNodeConstRef node, void* buffer, size_t bufferSize);
+
+/**
+ * Replaces the style of the node with a style encoded by
+ * YGNodeStyleSerialize(). The node is only marked dirty if its style changed.
+ *
+ * Returns false, leaving the node unchanged, if the encoding is malformed or
+ * of an unsupported version.
+ */
+YG_EXPORT bool YGNodeStyleDeserialize(
+    YGNodeRef node,
+    const void* buffer,
+    size_t bufferSize);
+
+/**
+ * Returns a 64-bit hash of the style of the node, which is kept up to date as
+ * the style changes, so is cheap to read. Nodes with equal styles have equal
+ * fingerprints. Nodes with different fingerprints have different styles, but
+ * nodes with equal fingerprints are not guaranteed to have equal styles.
+ *
+ * The fingerprint of a node with the default style is zero.
+ */
+YG_EXPORT uint64_t YGNodeStyleGetFingerprint(YGNodeConstRef node);
+
 YG_EXPORT void YGNodeStyleSetDirection(YGNodeRef node, YGDirection direction);
 YG_EXPORT YGDirection YGNodeStyleGetDirection(YGNodeConstRef node);
 
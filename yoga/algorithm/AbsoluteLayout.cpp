@@ -333,7 +333,7 @@ void layoutAbsoluteChild(
   // flexible.
   const auto& childStyle = child->style();
   if (yoga::isUndefined(childWidth) ^ yoga::isUndefined(childHeight)) {
-    if (childStyle.aspectRatio().isDefined()) {
+    if (childStyle.hasAspectRatio()) {
       if (yoga::isUndefined(childWidth)) {
         childWidth = marginRow +
             (childHeight - marginColumn) * childStyle.aspectRatio().unwrap();
@@ -421,6 +421,22 @@ void layoutAbsoluteChild(
       containingBlockHeight);
 }
 
+size_t countAbsoluteDescendants(const yoga::Node* node) {
+  size_t count = 0;
+  for (auto child : node->getLayoutChildren()) {
+    if (child->style().display() == Display::None) {
+      continue;
+    } else if (child->style().positionType() == PositionType::Absolute) {
+      count++;
+    } else if (
+        child->style().positionType() == PositionType::Static &&
+        !child->alwaysFormsContainingBlock()) {
+      count += child->getAbsoluteDescendantCount();
+    }
+  }
+  return count;
+}
+
 bool layoutAbsoluteDescendants(
     yoga::Node* containingNode,
     yoga::Node* currentNode,
@@ -520,7 +536,8 @@ bool layoutAbsoluteDescendants(
       child->setLayoutPosition(childTopOffsetFromParent, PhysicalEdge::Top);
     } else if (
         child->style().positionType() == PositionType::Static &&
-        !child->alwaysFormsContainingBlock()) {
+        !child->alwaysFormsContainingBlock() &&
+        child->getAbsoluteDescendantCount() != 0) {
       // We may write new layout results for absolute descendants of "child"
       // which are positioned relative to the current containing block instead
       // of their parent. "child" may not be dirty, or have new constraints, so
@@ -24,6 +24,12 @@ void layoutAbsoluteChild(
     uint32_t depth,
     uint32_t generationCount);
 
+// Counts the absolutely positioned nodes which the containing block of
+// `node`'s children is responsible for, using the counts last recorded on
+// its children. Static children are looked through, as they don't form a
+// containing block.
+size_t countAbsoluteDescendants(const yoga::Node* node);
+
 // Returns if some absolute descendant has new layout
 bool layoutAbsoluteDescendants(
     yoga::Node* containingNode,
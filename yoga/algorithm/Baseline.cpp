@@ -14,13 +14,23 @@
 
 namespace facebook::yoga {
 
-float calculateBaseline(const yoga::Node* node) {
+float calculateBaseline(yoga::Node* node, uint32_t generationCount) {
   if (node->hasBaselineFunc()) {
+    const float width = node->getLayout().measuredDimension(Dimension::Width);
+    const float height =
+        node->getLayout().measuredDimension(Dimension::Height);
+
+    // Baseline alignment asks for the same baselines several times per pass,
+    // and baseline functions may be expensive calls into the host
+    const auto& cachedBaseline = node->getLayout().cachedBaseline;
+    if (cachedBaseline.generation == generationCount &&
+        cachedBaseline.width == width && cachedBaseline.height == height) {
+      return cachedBaseline.baseline;
+    }
+
     Event::publish<Event::NodeBaselineStart>(node);
 
-    const float baseline = node->baseline(
-        node->getLayout().measuredDimension(Dimension::Width),
-        node->getLayout().measuredDimension(Dimension::Height));
+    const float baseline = node->baseline(width, height);
 
     Event::publish<Event::NodeBaselineEnd>(node);
 
@@ -28,6 +38,11 @@ float calculateBaseline(const yoga::Node* node) {
         node,
         !std::isnan(baseline),
         "Expect custom baseline function to not return NaN");
+    node->setLayoutCachedBaseline(
+        {.generation = generationCount,
+         .width = width,
+         .height = height,
+         .baseline = baseline});
     return baseline;
   }
 
@@ -54,7 +69,7 @@ float calculateBaseline(const yoga::Node* node) {
     return node->getLayout().measuredDimension(Dimension::Height);
   }
 
-  const float baseline = calculateBaseline(baselineChild);
+  const float baseline = calculateBaseline(baselineChild, generationCount);
   return baseline + baselineChild->getLayout().position(PhysicalEdge::Top);
 }
 
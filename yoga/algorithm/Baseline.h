@@ -13,7 +13,9 @@
 namespace facebook::yoga {
 
 // Calculate baseline represented as an offset from the top edge of the node.
-float calculateBaseline(const yoga::Node* node);
+// Results of baseline functions are reused for the rest of the layout pass
+// with the given generation, as long as the node keeps the same size.
+float calculateBaseline(yoga::Node* node, uint32_t generationCount);
 
 // Whether any of the children of this node participate in baseline alignment
 bool isBaselineLayout(const yoga::Node* node);
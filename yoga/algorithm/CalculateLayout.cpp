@@ -24,6 +24,7 @@
 #include <yoga/algorithm/PixelGrid.h>
 #include <yoga/algorithm/SizingMode.h>
 #include <yoga/algorithm/TrailingPosition.h>
+#include <yoga/debug/AllocationCounter.h>
 #include <yoga/debug/AssertFatal.h>
 #include <yoga/debug/Log.h>
 #include <yoga/event/event.h>
@@ -171,7 +172,7 @@ static void computeFlexBasisForChild(
     }
 
     const auto& childStyle = child->style();
-    if (childStyle.aspectRatio().isDefined()) {
+    if (childStyle.hasAspectRatio()) {
       if (!isMainAxisRow && childWidthSizingMode == SizingMode::StretchFit) {
         childHeight = marginColumn +
             (childWidth - marginRow) / childStyle.aspectRatio().unwrap();
@@ -196,7 +197,7 @@ static void computeFlexBasisForChild(
         childWidthStretch) {
       childWidth = width;
       childWidthSizingMode = SizingMode::StretchFit;
-      if (childStyle.aspectRatio().isDefined()) {
+      if (childStyle.hasAspectRatio()) {
         childHeight =
             (childWidth - marginRow) / childStyle.aspectRatio().unwrap();
         childHeightSizingMode = SizingMode::StretchFit;
@@ -213,7 +214,7 @@ static void computeFlexBasisForChild(
       childHeight = height;
       childHeightSizingMode = SizingMode::StretchFit;
 
-      if (childStyle.aspectRatio().isDefined()) {
+      if (childStyle.hasAspectRatio()) {
         childWidth =
             (childHeight - marginColumn) * childStyle.aspectRatio().unwrap();
         childWidthSizingMode = SizingMode::StretchFit;
@@ -611,12 +612,10 @@ static float computeFlexBasisForChildren(
 // of the flex items abide the min and max constraints. At the end of this
 // function the child nodes would have proper size. Prior using this function
 // please ensure that distributeFreeSpaceFirstPass is called.
+template <typename Axes>
 static float distributeFreeSpaceSecondPass(
     FlexLine& flexLine,
     yoga::Node* const node,
-    const FlexDirection mainAxis,
-    const FlexDirection crossAxis,
-    const Direction direction,
     const float ownerWidth,
     const float mainAxisOwnerSize,
     const float availableInnerMainDim,
@@ -629,11 +628,14 @@ static float distributeFreeSpaceSecondPass(
     LayoutData& layoutMarkerData,
     const uint32_t depth,
     const uint32_t generationCount) {
+  constexpr FlexDirection mainAxis = Axes::mainAxis;
+  constexpr FlexDirection crossAxis = Axes::crossAxis;
+  constexpr Direction direction = Axes::direction;
+  constexpr bool isMainAxisRow = Axes::isMainAxisRow;
   float childFlexBasis = 0;
   float flexShrinkScaledFactor = 0;
   float flexGrowFactor = 0;
   float deltaFreeSpace = 0;
-  const bool isMainAxisRow = isRow(mainAxis);
   const bool isNodeFlexWrap = node->style().flexWrap() != Wrap::NoWrap;
 
   for (auto currentLineChild : flexLine.itemsInFlow) {
@@ -705,7 +707,7 @@ static float distributeFreeSpaceSecondPass(
     SizingMode childMainSizingMode = SizingMode::StretchFit;
 
     const auto& childStyle = currentLineChild->style();
-    if (childStyle.aspectRatio().isDefined()) {
+    if (childStyle.hasAspectRatio()) {
       childCrossSize = isMainAxisRow
           ? (childMainSize - marginMain) / childStyle.aspectRatio().unwrap()
           : (childMainSize - marginMain) * childStyle.aspectRatio().unwrap();
@@ -810,14 +812,15 @@ static float distributeFreeSpaceSecondPass(
 // It distributes the free space to the flexible items.For those flexible items
 // whose min and max constraints are triggered, those flex item's clamped size
 // is removed from the remaingfreespace.
+template <typename Axes>
 static void distributeFreeSpaceFirstPass(
     FlexLine& flexLine,
-    const Direction direction,
-    const FlexDirection mainAxis,
     const float ownerWidth,
     const float mainAxisOwnerSize,
     const float availableInnerMainDim,
     const float availableInnerWidth) {
+  constexpr FlexDirection mainAxis = Axes::mainAxis;
+  constexpr Direction direction = Axes::direction;
   float flexShrinkScaledFactor = 0;
   float flexGrowFactor = 0;
   float baseMainSize = 0;
@@ -919,12 +922,10 @@ static void distributeFreeSpaceFirstPass(
 // At the end of this function the child nodes would have the proper size
 // assigned to them.
 //
+template <typename Axes>
 static void resolveFlexibleLength(
     yoga::Node* const node,
     FlexLine& flexLine,
-    const FlexDirection mainAxis,
-    const FlexDirection crossAxis,
-    const Direction direction,
     const float ownerWidth,
     const float mainAxisOwnerSize,
     const float availableInnerMainDim,
@@ -939,22 +940,17 @@ static void resolveFlexibleLength(
     const uint32_t generationCount) {
   const float originalFreeSpace = flexLine.layout.remainingFreeSpace;
   // First pass: detect the flex items whose min/max constraints trigger
-  distributeFreeSpaceFirstPass(
+  distributeFreeSpaceFirstPass<Axes>(
       flexLine,
-      direction,
-      mainAxis,
       ownerWidth,
       mainAxisOwnerSize,
       availableInnerMainDim,
       availableInnerWidth);
 
   // Second pass: resolve the sizes of the flexible items
-  const float distributedFreeSpace = distributeFreeSpaceSecondPass(
+  const float distributedFreeSpace = distributeFreeSpaceSecondPass<Axes>(
       flexLine,
       node,
-      mainAxis,
-      crossAxis,
-      direction,
       ownerWidth,
       mainAxisOwnerSize,
       availableInnerMainDim,
@@ -971,12 +967,10 @@ static void resolveFlexibleLength(
   flexLine.layout.remainingFreeSpace = originalFreeSpace - distributedFreeSpace;
 }
 
+template <typename Axes>
 static void justifyMainAxis(
     yoga::Node* const node,
     FlexLine& flexLine,
-    const FlexDirection mainAxis,
-    const FlexDirection crossAxis,
-    const Direction direction,
     const SizingMode sizingModeMainDim,
     const SizingMode sizingModeCrossDim,
     const float mainAxisOwnerSize,
@@ -984,7 +978,11 @@ static void justifyMainAxis(
     const float availableInnerMainDim,
     const float availableInnerCrossDim,
     const float availableInnerWidth,
-    const bool performLayout) {
+    const bool performLayout,
+    const uint32_t generationCount) {
+  constexpr FlexDirection mainAxis = Axes::mainAxis;
+  constexpr FlexDirection crossAxis = Axes::crossAxis;
+  constexpr Direction direction = Axes::direction;
   const auto& style = node->style();
 
   const float leadingPaddingAndBorderMain =
@@ -1116,7 +1114,7 @@ static void justifyMainAxis(
       if (isNodeBaselineLayout) {
         // If the child is baseline aligned then the cross dimension is
         // calculated by adding maxAscent and maxDescent from the baseline.
-        const float ascent = calculateBaseline(child) +
+        const float ascent = calculateBaseline(child, generationCount) +
             child->style().computeFlexStartMargin(
                 FlexDirection::Column, direction, availableInnerWidth);
         const float descent =
@@ -1147,6 +1145,458 @@ static void justifyMainAxis(
   }
 }
 
+// Fast path for the most common kind of container: a single line of
+// inflexible items (a "simple stack"). A container qualifies when it does not
+// wrap, none of its in-flow children can grow or shrink, none of them have
+// auto margins, and nothing in it is baseline aligned. Such a line needs no
+// free space distribution and no multi-line alignment, so STEPS 4 through 7
+// collapse to a classification pass followed by a single pass which lays out,
+// justifies and aligns each child, without materializing a FlexLine.
+//
+// Returns false, without modifying any layout state, if the container does not
+// qualify. Otherwise it advances the iterator past the last child and produces
+// the same results as the general algorithm.
+template <typename Axes>
+static bool layoutSimpleStack(
+    yoga::Node* const node,
+    const SizingMode sizingModeMainDim,
+    const SizingMode sizingModeCrossDim,
+    const float ownerWidth,
+    const float mainAxisOwnerSize,
+    const float crossAxisOwnerSize,
+    const float paddingAndBorderAxisMain,
+    const float paddingAndBorderAxisCross,
+    const float leadingPaddingAndBorderCross,
+    const float availableInnerWidth,
+    const float availableInnerHeight,
+    const float availableInnerCrossDim,
+    const bool performLayout,
+    LayoutData& layoutMarkerData,
+    const uint32_t depth,
+    const uint32_t generationCount,
+    Node::LayoutableChildren::Iterator& iterator,
+    /*in_out*/ float* availableInnerMainDim,
+    /*out*/ float* totalLineCrossDim,
+    /*out*/ float* maxLineMainDim) {
+  constexpr FlexDirection mainAxis = Axes::mainAxis;
+  constexpr FlexDirection crossAxis = Axes::crossAxis;
+  constexpr Direction direction = Axes::direction;
+  constexpr bool isMainAxisRow = Axes::isMainAxisRow;
+  const auto& style = node->style();
+  if (style.flexWrap() != Wrap::NoWrap ||
+      style.alignItems() == Align::Baseline) {
+    return false;
+  }
+
+  // Classify the children while accumulating the size of the line the same
+  // way calculateFlexLine does.
+  const float lineGap =
+      style.computeGapForAxis(mainAxis, *availableInnerMainDim);
+  float sizeConsumed = 0.0f;
+  size_t itemsInFlowCount = 0;
+  yoga::Node* lastItemInFlow = nullptr;
+  for (auto child : node->getLayoutChildren()) {
+    const auto& childStyle = child->style();
+    if (childStyle.positionType() == PositionType::Absolute) {
+      continue;
+    }
+    if (childStyle.alignSelf() == Align::Baseline) {
+      return false;
+    }
+    if (childStyle.display() == Display::None) {
+      continue;
+    }
+    if (childStyle.hasAutoMargin() || child->isNodeFlexible()) {
+      return false;
+    }
+
+    const float flexBasisWithMinAndMaxConstraints =
+        boundAxisWithinMinAndMax(
+            child,
+            direction,
+            mainAxis,
+            child->getLayout().computedFlexBasis,
+            mainAxisOwnerSize,
+            ownerWidth)
+            .unwrap();
+    if (!std::isfinite(flexBasisWithMinAndMaxConstraints)) {
+      return false;
+    }
+
+    sizeConsumed += flexBasisWithMinAndMaxConstraints +
+        childStyle.computeMarginForAxis(mainAxis, availableInnerWidth) +
+        (itemsInFlowCount == 0 ? 0.0f : lineGap);
+    itemsInFlowCount++;
+    lastItemInFlow = child;
+  }
+
+  if (itemsInFlowCount == 0) {
+    return false;
+  }
+
+  // From here on the container is known to be a simple stack.
+  iterator = node->getLayoutChildren().end();
+
+  // With nothing to flex, a line sized by its content is exactly as large as
+  // its content, unless min/max constraints say otherwise.
+  bool sizeBasedOnContent = false;
+  if (sizingModeMainDim != SizingMode::StretchFit) {
+    const float minInnerMainDim =
+        style
+            .resolvedMinDimension(
+                direction, dimension(mainAxis), mainAxisOwnerSize, ownerWidth)
+            .unwrap() -
+        paddingAndBorderAxisMain;
+    const float maxInnerMainDim =
+        style
+            .resolvedMaxDimension(
+                direction, dimension(mainAxis), mainAxisOwnerSize, ownerWidth)
+            .unwrap() -
+        paddingAndBorderAxisMain;
+
+    if (yoga::isDefined(minInnerMainDim) && sizeConsumed < minInnerMainDim) {
+      *availableInnerMainDim = minInnerMainDim;
+    } else if (
+        yoga::isDefined(maxInnerMainDim) && sizeConsumed > maxInnerMainDim) {
+      *availableInnerMainDim = maxInnerMainDim;
+    } else {
+      const bool useLegacyStretchBehaviour =
+          node->hasErrata(Errata::StretchFlexBasis);
+      if (!useLegacyStretchBehaviour) {
+        *availableInnerMainDim = sizeConsumed;
+      }
+      sizeBasedOnContent = !useLegacyStretchBehaviour;
+    }
+  }
+
+  float remainingFreeSpace = 0;
+  if (!sizeBasedOnContent && yoga::isDefined(*availableInnerMainDim)) {
+    remainingFreeSpace = *availableInnerMainDim - sizeConsumed;
+  } else if (sizeConsumed < 0) {
+    remainingFreeSpace = -sizeConsumed;
+  }
+
+  node->setLayoutHadOverflow(
+      node->getLayout().hadOverflow() || (remainingFreeSpace < 0));
+
+  // Main-axis justification, as in justifyMainAxis.
+  const float leadingPaddingAndBorderMain =
+      style.computeFlexStartPaddingAndBorder(mainAxis, direction, ownerWidth);
+  const float trailingPaddingAndBorderMain =
+      style.computeFlexEndPaddingAndBorder(mainAxis, direction, ownerWidth);
+
+  if (sizingModeMainDim == SizingMode::FitContent && remainingFreeSpace > 0) {
+    if (style.minDimension(dimension(mainAxis)).isDefined() &&
+        style
+            .resolvedMinDimension(
+                direction, dimension(mainAxis), mainAxisOwnerSize, ownerWidth)
+            .isDefined()) {
+      const float minAvailableMainDim =
+          style
+              .resolvedMinDimension(
+                  direction, dimension(mainAxis), mainAxisOwnerSize, ownerWidth)
+              .unwrap() -
+          leadingPaddingAndBorderMain - trailingPaddingAndBorderMain;
+      const float occupiedSpaceByChildNodes =
+          *availableInnerMainDim - remainingFreeSpace;
+      remainingFreeSpace = yoga::maxOrDefined(
+          0.0f, minAvailableMainDim - occupiedSpaceByChildNodes);
+    } else {
+      remainingFreeSpace = 0;
+    }
+  }
+
+  float leadingMainDim = 0;
+  float betweenMainDim =
+      style.computeGapForAxis(mainAxis, *availableInnerMainDim);
+  const Justify justifyContent = remainingFreeSpace >= 0
+      ? style.justifyContent()
+      : fallbackAlignment(style.justifyContent());
+  switch (justifyContent) {
+    case Justify::Center:
+      leadingMainDim = remainingFreeSpace / 2;
+      break;
+    case Justify::FlexEnd:
+      leadingMainDim = remainingFreeSpace;
+      break;
+    case Justify::SpaceBetween:
+      if (itemsInFlowCount > 1) {
+        betweenMainDim +=
+            remainingFreeSpace / static_cast<float>(itemsInFlowCount - 1);
+      }
+      break;
+    case Justify::SpaceEvenly:
+      leadingMainDim =
+          remainingFreeSpace / static_cast<float>(itemsInFlowCount + 1);
+      betweenMainDim += leadingMainDim;
+      break;
+    case Justify::SpaceAround:
+      leadingMainDim =
+          0.5f * remainingFreeSpace / static_cast<float>(itemsInFlowCount);
+      betweenMainDim += leadingMainDim * 2;
+      break;
+    case Justify::FlexStart:
+      break;
+  }
+
+  // If we don't need to measure the cross axis, we can skip laying out the
+  // children entirely.
+  const bool canSkipFlex =
+      !performLayout && sizingModeCrossDim == SizingMode::StretchFit;
+
+  float lineMainDim = leadingPaddingAndBorderMain + leadingMainDim;
+  float lineCrossDim = 0;
+  for (auto child : node->getLayoutChildren()) {
+    const auto& childStyle = child->style();
+    if (childStyle.display() == Display::None ||
+        childStyle.positionType() == PositionType::Absolute) {
+      continue;
+    }
+    child->setLineIndex(0);
+
+    if (!canSkipFlex) {
+      // Lay out the child at its (bounded) flex basis, as
+      // distributeFreeSpaceSecondPass would for an item which doesn't flex.
+      const float childFlexBasis = boundAxisWithinMinAndMax(
+                                       child,
+                                       direction,
+                                       mainAxis,
+                                       child->getLayout().computedFlexBasis,
+                                       mainAxisOwnerSize,
+                                       ownerWidth)
+                                       .unwrap();
+      const float marginMain =
+          childStyle.computeMarginForAxis(mainAxis, availableInnerWidth);
+      const float marginCross =
+          childStyle.computeMarginForAxis(crossAxis, availableInnerWidth);
+
+      float childCrossSize = YGUndefined;
+      float childMainSize = childFlexBasis + marginMain;
+      SizingMode childCrossSizingMode;
+      SizingMode childMainSizingMode = SizingMode::StretchFit;
+
+      const bool hasDefiniteCrossLength = child->hasDefiniteLength(
+          dimension(crossAxis), availableInnerCrossDim);
+      const bool isStretched = !hasDefiniteCrossLength &&
+          resolveChildAlignment(node, child) == Align::Stretch;
+
+      if (childStyle.hasAspectRatio()) {
+        childCrossSize = isMainAxisRow
+            ? (childMainSize - marginMain) / childStyle.aspectRatio().unwrap()
+            : (childMainSize - marginMain) * childStyle.aspectRatio().unwrap();
+        childCrossSizingMode = SizingMode::StretchFit;
+
+        childCrossSize += marginCross;
+      } else if (
+          !std::isnan(availableInnerCrossDim) && isStretched &&
+          sizingModeCrossDim == SizingMode::StretchFit) {
+        childCrossSize = availableInnerCrossDim;
+        childCrossSizingMode = SizingMode::StretchFit;
+      } else if (!hasDefiniteCrossLength) {
+        childCrossSize = availableInnerCrossDim;
+        childCrossSizingMode = yoga::isUndefined(childCrossSize)
+            ? SizingMode::MaxContent
+            : SizingMode::FitContent;
+      } else {
+        childCrossSize = child
+                             ->getResolvedDimension(
+                                 direction,
+                                 dimension(crossAxis),
+                                 availableInnerCrossDim,
+                                 availableInnerWidth)
+                             .unwrap() +
+            marginCross;
+        const bool isLoosePercentageMeasurement =
+            child->getProcessedDimension(dimension(crossAxis)).isPercent() &&
+            sizingModeCrossDim != SizingMode::StretchFit;
+        childCrossSizingMode =
+            yoga::isUndefined(childCrossSize) || isLoosePercentageMeasurement
+            ? SizingMode::MaxContent
+            : SizingMode::StretchFit;
+      }
+
+      constrainMaxSizeForMode(
+          child,
+          direction,
+          mainAxis,
+          *availableInnerMainDim,
+          availableInnerWidth,
+          &childMainSizingMode,
+          &childMainSize);
+      constrainMaxSizeForMode(
+          child,
+          direction,
+          crossAxis,
+          availableInnerCrossDim,
+          availableInnerWidth,
+          &childCrossSizingMode,
+          &childCrossSize);
+
+      const bool isLayoutPass = performLayout && !isStretched;
+      calculateLayoutInternal(
+          child,
+          isMainAxisRow ? childMainSize : childCrossSize,
+          !isMainAxisRow ? childMainSize : childCrossSize,
+          node->getLayout().direction(),
+          isMainAxisRow ? childMainSizingMode : childCrossSizingMode,
+          !isMainAxisRow ? childMainSizingMode : childCrossSizingMode,
+          availableInnerWidth,
+          availableInnerHeight,
+          isLayoutPass,
+          isLayoutPass ? LayoutPassReason::kFlexLayout
+                       : LayoutPassReason::kFlexMeasure,
+          layoutMarkerData,
+          depth,
+          generationCount);
+      node->setLayoutHadOverflow(
+          node->getLayout().hadOverflow() || child->getLayout().hadOverflow());
+    }
+
+    if (performLayout) {
+      child->setLayoutPosition(
+          child->getLayout().position(flexStartEdge(mainAxis)) + lineMainDim,
+          flexStartEdge(mainAxis));
+    }
+
+    if (child != lastItemInFlow) {
+      lineMainDim += betweenMainDim;
+    }
+
+    if (canSkipFlex) {
+      // If we skipped the flex step, then we can't rely on the measuredDims
+      // because they weren't computed. This means we can't call
+      // dimensionWithMargin.
+      lineMainDim +=
+          childStyle.computeMarginForAxis(mainAxis, availableInnerWidth) +
+          child->getLayout().computedFlexBasis.unwrap();
+      lineCrossDim = availableInnerCrossDim;
+    } else {
+      lineMainDim += child->dimensionWithMargin(mainAxis, availableInnerWidth);
+      lineCrossDim = yoga::maxOrDefined(
+          lineCrossDim,
+          child->dimensionWithMargin(crossAxis, availableInnerWidth));
+    }
+  }
+  lineMainDim += trailingPaddingAndBorderMain;
+
+  float containerCrossAxis = availableInnerCrossDim;
+  if (sizingModeCrossDim == SizingMode::MaxContent ||
+      sizingModeCrossDim == SizingMode::FitContent) {
+    containerCrossAxis =
+        boundAxis(
+            node,
+            crossAxis,
+            direction,
+            lineCrossDim + paddingAndBorderAxisCross,
+            crossAxisOwnerSize,
+            ownerWidth) -
+        paddingAndBorderAxisCross;
+  }
+
+  if (sizingModeCrossDim == SizingMode::StretchFit) {
+    lineCrossDim = availableInnerCrossDim;
+  }
+  lineCrossDim = boundAxis(
+                     node,
+                     crossAxis,
+                     direction,
+                     lineCrossDim + paddingAndBorderAxisCross,
+                     crossAxisOwnerSize,
+                     ownerWidth) -
+      paddingAndBorderAxisCross;
+
+  // Cross-axis alignment, as in STEP 7.
+  if (performLayout) {
+    for (auto child : node->getLayoutChildren()) {
+      if (child->style().display() == Display::None ||
+          child->style().positionType() == PositionType::Absolute) {
+        continue;
+      }
+      float leadingCrossDim = leadingPaddingAndBorderCross;
+      const Align alignItem = resolveChildAlignment(node, child);
+
+      if (alignItem == Align::Stretch) {
+        if (!child->hasDefiniteLength(
+                dimension(crossAxis), availableInnerCrossDim)) {
+          float childMainSize =
+              child->getLayout().measuredDimension(dimension(mainAxis));
+          const auto& childStyle = child->style();
+          float childCrossSize = childStyle.hasAspectRatio()
+              ? childStyle.computeMarginForAxis(
+                    crossAxis, availableInnerWidth) +
+                  (isMainAxisRow
+                       ? childMainSize / childStyle.aspectRatio().unwrap()
+                       : childMainSize * childStyle.aspectRatio().unwrap())
+              : lineCrossDim;
+
+          childMainSize +=
+              childStyle.computeMarginForAxis(mainAxis, availableInnerWidth);
+
+          SizingMode childMainSizingMode = SizingMode::StretchFit;
+          SizingMode childCrossSizingMode = SizingMode::StretchFit;
+          constrainMaxSizeForMode(
+              child,
+              direction,
+              mainAxis,
+              *availableInnerMainDim,
+              availableInnerWidth,
+              &childMainSizingMode,
+              &childMainSize);
+          constrainMaxSizeForMode(
+              child,
+              direction,
+              crossAxis,
+              availableInnerCrossDim,
+              availableInnerWidth,
+              &childCrossSizingMode,
+              &childCrossSize);
+
+          const float childWidth =
+              isMainAxisRow ? childMainSize : childCrossSize;
+          const float childHeight =
+              !isMainAxisRow ? childMainSize : childCrossSize;
+
+          calculateLayoutInternal(
+              child,
+              childWidth,
+              childHeight,
+              direction,
+              yoga::isUndefined(childWidth) ? SizingMode::MaxContent
+                                            : SizingMode::StretchFit,
+              yoga::isUndefined(childHeight) ? SizingMode::MaxContent
+                                             : SizingMode::StretchFit,
+              availableInnerWidth,
+              availableInnerHeight,
+              true,
+              LayoutPassReason::kStretch,
+              layoutMarkerData,
+              depth,
+              generationCount);
+        }
+      } else {
+        const float remainingCrossDim = containerCrossAxis -
+            child->dimensionWithMargin(crossAxis, availableInnerWidth);
+
+        if (alignItem == Align::FlexStart) {
+          // No-Op
+        } else if (alignItem == Align::Center) {
+          leadingCrossDim += remainingCrossDim / 2;
+        } else {
+          leadingCrossDim += remainingCrossDim;
+        }
+      }
+      child->setLayoutPosition(
+          child->getLayout().position(flexStartEdge(crossAxis)) +
+              *totalLineCrossDim + leadingCrossDim,
+          flexStartEdge(crossAxis));
+    }
+  }
+
+  *totalLineCrossDim += lineCrossDim;
+  *maxLineMainDim = yoga::maxOrDefined(*maxLineMainDim, lineMainDim);
+  return true;
+}
+
 //
 // This is the main routine that implements a subset of the flexbox layout
 // algorithm described in the W3C CSS documentation:
@@ -1310,6 +1760,7 @@ static void calculateLayoutImpl(
     // Clean and update all display: contents nodes with a direct path to the
     // current node as they will not be traversed
     cleanupContentsNodesRecursively(node);
+    node->setAbsoluteDescendantCount(0);
     return;
   }
 
@@ -1328,6 +1779,7 @@ static void calculateLayoutImpl(
     // Clean and update all display: contents nodes with a direct path to the
     // current node as they will not be traversed
     cleanupContentsNodesRecursively(node);
+    node->setAbsoluteDescendantCount(0);
     return;
   }
 
@@ -1459,6 +1911,35 @@ static void calculateLayoutImpl(
 
   // Max main dimension of all the lines.
   float maxLineMainDim = 0;
+
+  // A single line of inflexible items is laid out by a dedicated fast path,
+  // which consumes every child and leaves nothing for the general loop below.
+  const bool isSimpleStack =
+      node->getConfig()->isSimpleStackFastPathEnabled() &&
+      withStaticAxes(mainAxis, direction, [&](auto axes) {
+        return layoutSimpleStack<decltype(axes)>(
+            node,
+            sizingModeMainDim,
+            sizingModeCrossDim,
+            ownerWidth,
+            mainAxisOwnerSize,
+            crossAxisOwnerSize,
+            paddingAndBorderAxisMain,
+            paddingAndBorderAxisCross,
+            leadingPaddingAndBorderCross,
+            availableInnerWidth,
+            availableInnerHeight,
+            availableInnerCrossDim,
+            performLayout,
+            layoutMarkerData,
+            depth,
+            generationCount,
+            startOfLineIterator,
+            &availableInnerMainDim,
+            &totalLineCrossDim,
+            &maxLineMainDim);
+      });
+
   for (; startOfLineIterator != node->getLayoutChildren().end(); lineCount++) {
     auto flexLine = calculateFlexLine(
         node,
@@ -1553,24 +2034,23 @@ static void calculateLayoutImpl(
     }
 
     if (!canSkipFlex) {
-      resolveFlexibleLength(
-          node,
-          flexLine,
-          mainAxis,
-          crossAxis,
-          direction,
-          ownerWidth,
-          mainAxisOwnerSize,
-          availableInnerMainDim,
-          availableInnerCrossDim,
-          availableInnerWidth,
-          availableInnerHeight,
-          mainAxisOverflows,
-          sizingModeCrossDim,
-          performLayout,
-          layoutMarkerData,
-          depth,
-          generationCount);
+      withStaticAxes(mainAxis, direction, [&](auto axes) {
+        resolveFlexibleLength<decltype(axes)>(
+            node,
+            flexLine,
+            ownerWidth,
+            mainAxisOwnerSize,
+            availableInnerMainDim,
+            availableInnerCrossDim,
+            availableInnerWidth,
+            availableInnerHeight,
+            mainAxisOverflows,
+            sizingModeCrossDim,
+            performLayout,
+            layoutMarkerData,
+            depth,
+            generationCount);
+      });
     }
 
     node->setLayoutHadOverflow(
@@ -1584,20 +2064,20 @@ static void calculateLayoutImpl(
     // of items that are aligned "stretch". We need to compute these stretch
     // values and set the final positions.
 
-    justifyMainAxis(
-        node,
-        flexLine,
-        mainAxis,
-        crossAxis,
-        direction,
-        sizingModeMainDim,
-        sizingModeCrossDim,
-        mainAxisOwnerSize,
-        ownerWidth,
-        availableInnerMainDim,
-        availableInnerCrossDim,
-        availableInnerWidth,
-        performLayout);
+    withStaticAxes(mainAxis, direction, [&](auto axes) {
+      justifyMainAxis<decltype(axes)>(
+          node,
+          flexLine,
+          sizingModeMainDim,
+          sizingModeCrossDim,
+          mainAxisOwnerSize,
+          ownerWidth,
+          availableInnerMainDim,
+          availableInnerCrossDim,
+          availableInnerWidth,
+          performLayout,
+          generationCount);
+    });
 
     float containerCrossAxis = availableInnerCrossDim;
     if (sizingModeCrossDim == SizingMode::MaxContent ||
@@ -1659,7 +2139,7 @@ static void calculateLayoutImpl(
             float childMainSize =
                 child->getLayout().measuredDimension(dimension(mainAxis));
             const auto& childStyle = child->style();
-            float childCrossSize = childStyle.aspectRatio().isDefined()
+            float childCrossSize = childStyle.hasAspectRatio()
                 ? child->style().computeMarginForAxis(
                       crossAxis, availableInnerWidth) +
                     (isMainAxisRow
@@ -1759,7 +2239,8 @@ static void calculateLayoutImpl(
 
   // STEP 8: MULTI-LINE CONTENT ALIGNMENT
   // currentLead stores the size of the cross dim
-  if (performLayout && (isNodeFlexWrap || isBaselineLayout(node))) {
+  if (performLayout && !isSimpleStack &&
+      (isNodeFlexWrap || isBaselineLayout(node))) {
     float leadPerLine = 0;
     float currentLead = leadingPaddingAndBorderCross;
     float extraSpacePerLine = 0;
@@ -1850,7 +2331,7 @@ static void calculateLayoutImpl(
                         crossAxis, availableInnerWidth));
           }
           if (resolveChildAlignment(node, child) == Align::Baseline) {
-            const float ascent = calculateBaseline(child) +
+            const float ascent = calculateBaseline(child, generationCount) +
                 child->style().computeFlexStartMargin(
                     FlexDirection::Column, direction, availableInnerWidth);
             const float descent =
@@ -1957,7 +2438,7 @@ static void calculateLayoutImpl(
             case Align::Baseline: {
               child->setLayoutPosition(
                   currentLead + maxAscentForCurrentLine -
-                      calculateBaseline(child) +
+                      calculateBaseline(child, generationCount) +
                       child->style().computeFlexStartPosition(
                           FlexDirection::Column,
                           direction,
@@ -2111,9 +2592,13 @@ static void calculateLayoutImpl(
     }
 
     // STEP 11: SIZING AND POSITIONING ABSOLUTE CHILDREN
+    // Children have all been laid out by now, so their counts are current.
+    node->setAbsoluteDescendantCount(countAbsoluteDescendants(node));
+
     // Let the containing block layout its absolute descendants.
-    if (node->style().positionType() != PositionType::Static ||
-        node->alwaysFormsContainingBlock() || depth == 1) {
+    if ((node->style().positionType() != PositionType::Static ||
+         node->alwaysFormsContainingBlock() || depth == 1) &&
+        node->getAbsoluteDescendantCount() != 0) {
       layoutAbsoluteDescendants(
           node,
           node,
@@ -2152,6 +2637,7 @@ bool calculateLayoutInternal(
     LayoutData& layoutMarkerData,
     uint32_t depth,
     const uint32_t generationCount) {
+  Event::publish<Event::NodeLayoutStart>(node, {reason});
   LayoutResults* layout = &node->getLayout();
 
   depth++;
@@ -2173,6 +2659,7 @@ bool calculateLayoutInternal(
   }
 
   CachedMeasurement* cachedResults = nullptr;
+  bool cacheEvicted = false;
 
   // Determine whether the results are already cached. We maintain a separate
   // cache for layouts and measurements. A layout operation modifies the
@@ -2284,6 +2771,8 @@ bool calculateLayoutInternal(
       if (layout->nextCachedMeasurementsIndex ==
           LayoutResults::MaxCachedMeasurements) {
         layout->nextCachedMeasurementsIndex = 0;
+        cacheEvicted = true;
+        layoutMarkerData.measureCacheEvictions += 1;
       }
 
       CachedMeasurement* newCacheEntry = nullptr;
@@ -2331,7 +2820,13 @@ bool calculateLayoutInternal(
     layoutType = cachedResults != nullptr ? LayoutType::kCachedMeasure
                                           : LayoutType::kMeasure;
   }
-  Event::publish<Event::NodeLayout>(node, {layoutType});
+  const bool fromMeasurementCache = !needToVisitNode &&
+      cachedResults != nullptr && cachedResults != &layout->cachedLayout;
+  const int32_t cacheSlot = fromMeasurementCache
+      ? static_cast<int32_t>(cachedResults - layout->cachedMeasurements.data())
+      : -1;
+  Event::publish<Event::NodeLayout>(
+      node, {layoutType, reason, cacheSlot, needToVisitNode, cacheEvicted});
 
   return (needToVisitNode || cachedResults == nullptr);
 }
@@ -2343,6 +2838,7 @@ void calculateLayout(
     const Direction ownerDirection) {
   Event::publish<Event::LayoutPassStart>(node);
   LayoutData markerData = {};
+  const AllocationCounts allocationsBefore = threadAllocationCounts();
 
   // Increment the generation count. This will force the recursive routine to
   // visit all dirty nodes at least once. Subsequent visits will be skipped if
@@ -2422,6 +2918,10 @@ void calculateLayout(
     roundLayoutResultsToPixelGrid(node, 0.0f, 0.0f);
   }
 
+  const AllocationCounts& allocationsAfter = threadAllocationCounts();
+  markerData.allocations =
+      allocationsAfter.allocations - allocationsBefore.allocations;
+  markerData.allocatedBytes = allocationsAfter.bytes - allocationsBefore.bytes;
   Event::publish<Event::LayoutPassEnd>(node, {&markerData});
 }
 
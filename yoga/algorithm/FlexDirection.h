@@ -18,17 +18,17 @@
 
 namespace facebook::yoga {
 
-inline bool isRow(const FlexDirection flexDirection) {
+constexpr bool isRow(const FlexDirection flexDirection) {
   return flexDirection == FlexDirection::Row ||
       flexDirection == FlexDirection::RowReverse;
 }
 
-inline bool isColumn(const FlexDirection flexDirection) {
+constexpr bool isColumn(const FlexDirection flexDirection) {
   return flexDirection == FlexDirection::Column ||
       flexDirection == FlexDirection::ColumnReverse;
 }
 
-inline FlexDirection resolveDirection(
+constexpr FlexDirection resolveDirection(
     const FlexDirection flexDirection,
     const Direction direction) {
   if (direction == Direction::RTL) {
@@ -42,7 +42,7 @@ inline FlexDirection resolveDirection(
   return flexDirection;
 }
 
-inline FlexDirection resolveCrossDirection(
+constexpr FlexDirection resolveCrossDirection(
     const FlexDirection flexDirection,
     const Direction direction) {
   return isColumn(flexDirection)
@@ -50,7 +50,7 @@ inline FlexDirection resolveCrossDirection(
       : FlexDirection::Column;
 }
 
-inline PhysicalEdge flexStartEdge(FlexDirection flexDirection) {
+constexpr PhysicalEdge flexStartEdge(FlexDirection flexDirection) {
   switch (flexDirection) {
     case FlexDirection::Column:
       return PhysicalEdge::Top;
@@ -65,7 +65,7 @@ inline PhysicalEdge flexStartEdge(FlexDirection flexDirection) {
   fatalWithMessage("Invalid FlexDirection");
 }
 
-inline PhysicalEdge flexEndEdge(FlexDirection flexDirection) {
+constexpr PhysicalEdge flexEndEdge(FlexDirection flexDirection) {
   switch (flexDirection) {
     case FlexDirection::Column:
       return PhysicalEdge::Bottom;
@@ -80,7 +80,7 @@ inline PhysicalEdge flexEndEdge(FlexDirection flexDirection) {
   fatalWithMessage("Invalid FlexDirection");
 }
 
-inline PhysicalEdge inlineStartEdge(
+constexpr PhysicalEdge inlineStartEdge(
     FlexDirection flexDirection,
     Direction direction) {
   if (isRow(flexDirection)) {
@@ -91,7 +91,7 @@ inline PhysicalEdge inlineStartEdge(
   return PhysicalEdge::Top;
 }
 
-inline PhysicalEdge inlineEndEdge(
+constexpr PhysicalEdge inlineEndEdge(
     FlexDirection flexDirection,
     Direction direction) {
   if (isRow(flexDirection)) {
@@ -102,7 +102,7 @@ inline PhysicalEdge inlineEndEdge(
   return PhysicalEdge::Bottom;
 }
 
-inline Dimension dimension(FlexDirection flexDirection) {
+constexpr Dimension dimension(FlexDirection flexDirection) {
   switch (flexDirection) {
     case FlexDirection::Column:
       return Dimension::Height;
@@ -117,4 +117,46 @@ inline Dimension dimension(FlexDirection flexDirection) {
   fatalWithMessage("Invalid FlexDirection");
 }
 
+// The resolved main axis and layout direction of a container as compile-time
+// constants, along with the axes derived from them. Hot layout routines are
+// instantiated once per combination so that axis and edge lookups in their
+// inner loops resolve at compile time instead of branching per child.
+template <FlexDirection MainAxis, Direction LayoutDirection>
+struct StaticAxes {
+  static_assert(
+      LayoutDirection == Direction::LTR || LayoutDirection == Direction::RTL);
+
+  static constexpr FlexDirection mainAxis = MainAxis;
+  static constexpr FlexDirection crossAxis =
+      resolveCrossDirection(MainAxis, LayoutDirection);
+  static constexpr Direction direction = LayoutDirection;
+  static constexpr bool isMainAxisRow = isRow(MainAxis);
+};
+
+// Invokes `fn` with the StaticAxes matching a resolved main axis and a
+// resolved (LTR or RTL) layout direction.
+template <typename Fn>
+decltype(auto)
+withStaticAxes(FlexDirection mainAxis, Direction direction, Fn&& fn) {
+  const bool isRTL = direction == Direction::RTL;
+  switch (mainAxis) {
+    case FlexDirection::Column:
+      return isRTL ? fn(StaticAxes<FlexDirection::Column, Direction::RTL>{})
+                   : fn(StaticAxes<FlexDirection::Column, Direction::LTR>{});
+    case FlexDirection::ColumnReverse:
+      return isRTL
+          ? fn(StaticAxes<FlexDirection::ColumnReverse, Direction::RTL>{})
+          : fn(StaticAxes<FlexDirection::ColumnReverse, Direction::LTR>{});
+    case FlexDirection::Row:
+      return isRTL ? fn(StaticAxes<FlexDirection::Row, Direction::RTL>{})
+                   : fn(StaticAxes<FlexDirection::Row, Direction::LTR>{});
+    case FlexDirection::RowReverse:
+      return isRTL
+          ? fn(StaticAxes<FlexDirection::RowReverse, Direction::RTL>{})
+          : fn(StaticAxes<FlexDirection::RowReverse, Direction::LTR>{});
+  }
+
+  fatalWithMessage("Invalid FlexDirection");
+}
+
 } // namespace facebook::yoga
@@ -22,7 +22,7 @@ FlexLine calculateFlexLine(
     const float availableInnerMainDim,
     Node::LayoutableChildren::Iterator& iterator,
     const size_t lineCount) {
-  std::vector<yoga::Node*> itemsInFlow;
+  std::vector<yoga::Node*, CountingAllocator<yoga::Node*>> itemsInFlow;
   itemsInFlow.reserve(node->getChildCount());
 
   float sizeConsumed = 0.0f;
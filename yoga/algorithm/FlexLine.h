@@ -10,6 +10,7 @@
 #include <vector>
 
 #include <yoga/Yoga.h>
+#include <yoga/debug/AllocationCounter.h>
 #include <yoga/node/Node.h>
 
 namespace facebook::yoga {
@@ -41,7 +42,8 @@ struct FlexLine {
   // List of children which are part of the line flow. This means they are not
   // positioned absolutely, or with `display: "none"`, and do not overflow the
   // available dimensions.
-  const std::vector<yoga::Node*> itemsInFlow{};
+  const std::vector<yoga::Node*, CountingAllocator<yoga::Node*>>
+      itemsInFlow{};
 
   // Accumulation of the dimensions and margin of all the children on the
   // current line. This will be used in order to either set the dimensions of
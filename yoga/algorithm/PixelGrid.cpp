@@ -62,10 +62,11 @@ float roundValueToPixelGrid(
       : (float)(scaledValue / pointScaleFactor);
 }
 
-void roundLayoutResultsToPixelGrid(
+static void roundLayoutResultsToPixelGrid(
     yoga::Node* const node,
     const double absoluteLeft,
-    const double absoluteTop) {
+    const double absoluteTop,
+    const bool displayed) {
   const auto pointScaleFactor = node->getConfig()->getPointScaleFactor();
 
   const double nodeLeft = node->getLayout().position(PhysicalEdge::Left);
@@ -124,9 +125,31 @@ void roundLayoutResultsToPixelGrid(
         Dimension::Height);
   }
 
+  // The layout of this node is now final, though its children still need to
+  // be rounded. Nodes which kept their layout, or which are not displayed,
+  // have nothing new to report.
+  if (displayed && node->getHasNewLayout()) {
+    node->getConfig()->notifyLayoutComplete(node);
+  }
+
   for (yoga::Node* child : node->getChildren()) {
-    roundLayoutResultsToPixelGrid(child, absoluteNodeLeft, absoluteNodeTop);
+    roundLayoutResultsToPixelGrid(
+        child,
+        absoluteNodeLeft,
+        absoluteNodeTop,
+        displayed && child->style().display() != Display::None);
   }
 }
 
+void roundLayoutResultsToPixelGrid(
+    yoga::Node* const node,
+    const double absoluteLeft,
+    const double absoluteTop) {
+  roundLayoutResultsToPixelGrid(
+      node,
+      absoluteLeft,
+      absoluteTop,
+      node->style().display() != Display::None);
+}
+
 } // namespace facebook::yoga
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cmath>
+#include <utility>
+
+#include <yoga/Yoga.h>
+
+#include <yoga/algorithm/Baseline.h>
+#include <yoga/algorithm/FlexDirection.h>
+#include <yoga/algorithm/Reposition.h>
+#include <yoga/algorithm/TrailingPosition.h>
+#include <yoga/numeric/Comparison.h>
+
+namespace facebook::yoga {
+
+using Inset = InsetOffsets::Inset;
+
+// The inset which positions a node along the given axis, following the same
+// priority as layout, along with its value. Returns nothing if the value
+// depends on the size of the containing block.
+static std::optional<std::pair<Inset, float>>
+usedInset(const Style& style, FlexDirection axis, Direction direction) {
+  const auto start = style.inlineStartPosition(axis, direction);
+  if (start.isDefined() && !start.isAuto()) {
+    if (!start.isPoints()) {
+      return std::nullopt;
+    }
+    return std::pair{Inset::InlineStart, start.value().unwrap()};
+  }
+
+  const auto end = style.inlineEndPosition(axis, direction);
+  if (end.isDefined() && !end.isAuto()) {
+    if (!end.isPoints()) {
+      return std::nullopt;
+    }
+    return std::pair{Inset::InlineEnd, end.value().unwrap()};
+  }
+
+  return std::pair{Inset::None, 0.0f};
+}
+
+// Absolutely positioned nodes without a definite size are stretched between
+// their insets when both are set
+static bool absoluteSizeDependsOnInsets(
+    const yoga::Node* node,
+    FlexDirection axis,
+    Direction direction) {
+  const auto size = node->getProcessedDimension(dimension(axis));
+  if (size.isPoints() && size.value().unwrap() >= 0.0f) {
+    return false;
+  }
+
+  const auto& style = node->style();
+  return style.isFlexStartPositionDefined(axis, direction) &&
+      style.isFlexEndPositionDefined(axis, direction) &&
+      !style.isFlexStartPositionAuto(axis, direction) &&
+      !style.isFlexEndPositionAuto(axis, direction);
+}
+
+std::optional<InsetOffsets> computeInsetOffsets(const yoga::Node* node) {
+  const yoga::Node* parent = node->getOwner();
+  if (parent == nullptr || node->isDirty() || parent->isDirty() ||
+      node->style().display() != Display::Flex ||
+      parent->style().display() != Display::Flex) {
+    return std::nullopt;
+  }
+
+  const auto& style = node->style();
+  const Direction direction = parent->getLayout().direction();
+  if (node->getLayout().direction() != direction) {
+    return std::nullopt;
+  }
+
+  // Flex items are placed relative to their insets, unless the parent places
+  // them by baseline or in multiple lines, which may not
+  const bool isAbsolute = style.positionType() == PositionType::Absolute;
+  if (!isAbsolute &&
+      (parent->style().flexWrap() != Wrap::NoWrap ||
+       isBaselineLayout(parent))) {
+    return std::nullopt;
+  }
+
+  const FlexDirection mainAxis =
+      resolveDirection(parent->style().flexDirection(), direction);
+  const FlexDirection crossAxis = resolveCrossDirection(mainAxis, direction);
+
+  InsetOffsets result;
+  if (style.positionType() == PositionType::Static) {
+    return result;
+  }
+
+  for (const auto axis : {FlexDirection::Row, FlexDirection::Column}) {
+    const auto inset = usedInset(style, axis, direction);
+    if (!inset.has_value()) {
+      return std::nullopt;
+    }
+
+    // Offset towards the inline-end edge of the axis
+    const float offset =
+        inset->first == Inset::InlineEnd ? -inset->second : inset->second;
+    const FlexDirection parentAxis =
+        isRow(mainAxis) == isRow(axis) ? mainAxis : crossAxis;
+    const bool isReversed = needsTrailingPosition(parentAxis);
+
+    float leadingOffset = 0.0f;
+    float trailingOffset = 0.0f;
+    if (isAbsolute) {
+      if (absoluteSizeDependsOnInsets(node, axis, direction)) {
+        return std::nullopt;
+      }
+      // Absolute positions are measured from the flex-start edge, then
+      // mirrored onto the opposite edge for reversed axes
+      const float flexStartOffset =
+          inlineStartEdge(parentAxis, direction) == flexStartEdge(parentAxis)
+          ? offset
+          : -offset;
+      leadingOffset = isReversed ? -flexStartOffset : flexStartOffset;
+      trailingOffset = isReversed ? flexStartOffset : offset;
+    } else {
+      // Relative offsets apply to both edges, before reversed axes mirror the
+      // leading edge
+      leadingOffset = isReversed ? -offset : offset;
+      trailingOffset = offset;
+    }
+
+    const size_t axisIndex = isRow(axis) ? 0 : 1;
+    if (isAbsolute) {
+      result.insets[axisIndex] = inset->first;
+      result.insetsDefined[axisIndex] = isRow(axis)
+          ? style.horizontalInsetsDefined()
+          : style.verticalInsetsDefined();
+    }
+    result.offsets[yoga::to_underlying(inlineStartEdge(axis, Direction::LTR))] =
+        leadingOffset;
+    result.offsets[yoga::to_underlying(inlineEndEdge(axis, Direction::LTR))] =
+        trailingOffset;
+  }
+
+  return result;
+}
+
+// Whether the top edge of a node may be used to compute the baseline of an
+// ancestor. Rows laid out by baseline measure the baseline of every child, not
+// only of those aligned by it, so any such row above the parent counts.
+static bool mayAffectBaselineAlignment(const yoga::Node* node) {
+  if (node->style().positionType() == PositionType::Absolute) {
+    return false;
+  }
+
+  for (const yoga::Node* ancestor = node->getOwner()->getOwner();
+       ancestor != nullptr;
+       ancestor = ancestor->getOwner()) {
+    if (isBaselineLayout(ancestor)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool repositionNode(
+    yoga::Node* node,
+    const InsetOffsets& from,
+    const InsetOffsets& to) {
+  if (from.insets != to.insets || from.insetsDefined != to.insetsDefined) {
+    return false;
+  }
+
+  // Layout positions have already been rounded to the pixel grid, so they may
+  // only move by whole pixels to stay where layout would put them
+  const float pointScaleFactor = node->getConfig()->getPointScaleFactor();
+  std::array<float, 4> deltas{};
+  for (size_t i = 0; i < deltas.size(); i++) {
+    deltas[i] = to.offsets[i] - from.offsets[i];
+    const float scaledDelta = deltas[i] * pointScaleFactor;
+    if (pointScaleFactor != 0.0f &&
+        !yoga::inexactEquals(scaledDelta, std::round(scaledDelta))) {
+      return false;
+    }
+  }
+
+  if (deltas[yoga::to_underlying(PhysicalEdge::Top)] != 0.0f &&
+      mayAffectBaselineAlignment(node)) {
+    return false;
+  }
+
+  bool moved = false;
+  for (size_t i = 0; i < deltas.size(); i++) {
+    if (deltas[i] != 0.0f) {
+      const auto edge = static_cast<PhysicalEdge>(i);
+      node->setLayoutPosition(
+          node->getLayout().position(edge) + deltas[i], edge);
+      moved = true;
+    }
+  }
+  // Like layout does, flag the path from the root so that traversals which
+  // stop at nodes without new layout still reach the moved node
+  for (auto* n = node; moved && n != nullptr; n = n->getOwner()) {
+    n->setHasNewLayout(true);
+  }
+  // The node has its final layout, as the rounding pass would have reported
+  if (moved) {
+    node->getConfig()->notifyLayoutComplete(node);
+  }
+  return true;
+}
+
+} // namespace facebook::yoga
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include <yoga/Yoga.h>
+#include <yoga/node/Node.h>
+
+namespace facebook::yoga {
+
+// The parts of the layout position of a node which come from its insets
+struct InsetOffsets {
+  // Which inset positions the node along each of the row and column axes, for
+  // absolutely positioned nodes.
+  enum class Inset : uint8_t { None, InlineStart, InlineEnd };
+  std::array<Inset, 2> insets{};
+  std::array<bool, 2> insetsDefined{};
+
+  // The amount the insets add to the layout position of each physical edge
+  std::array<float, 4> offsets{};
+};
+
+// Returns how the insets of a laid out node offset its layout position, or
+// nothing if changing its insets may affect more than the position of the node
+// (e.g. when insets determine its size, or when they are percentages).
+std::optional<InsetOffsets> computeInsetOffsets(const yoga::Node* node);
+
+// Moves a node whose insets changed from giving offsets `from` to giving
+// offsets `to`, as a layout pass would have. Returns false without changing
+// anything if the node cannot be moved in isolation and layout needs to be
+// recalculated instead.
+bool repositionNode(
+    yoga::Node* node,
+    const InsetOffsets& from,
+    const InsetOffsets& to);
+
+} // namespace facebook::yoga
@@ -28,6 +28,14 @@ bool Config::useWebDefaults() const {
   return useWebDefaults_;
 }
 
+void Config::setSimpleStackFastPathEnabled(bool enabled) {
+  simpleStackFastPathEnabled_ = enabled;
+}
+
+bool Config::isSimpleStackFastPathEnabled() const {
+  return simpleStackFastPathEnabled_;
+}
+
 void Config::setExperimentalFeatureEnabled(
     ExperimentalFeature feature,
     bool enabled) {
@@ -127,6 +135,16 @@ YGNodeRef Config::cloneNode(
   return clone;
 }
 
+void Config::setLayoutCompleteCallback(YGLayoutCompleteFunc layoutComplete) {
+  layoutCompleteCallback_ = layoutComplete;
+}
+
+void Config::notifyLayoutComplete(YGNodeConstRef node) const {
+  if (layoutCompleteCallback_ != nullptr) {
+    layoutCompleteCallback_(node);
+  }
+}
+
 /*static*/ const Config& Config::getDefault() {
   static Config config{getDefaultLogger()};
   return config;
@@ -37,6 +37,12 @@ class YG_EXPORT Config : public ::YGConfig {
   void setUseWebDefaults(bool useWebDefaults);
   bool useWebDefaults() const;
 
+  // Whether containers which qualify as a "simple stack" may be laid out by
+  // the specialized fast path instead of the general flex line algorithm.
+  // Both produce identical results, so this does not invalidate layout.
+  void setSimpleStackFastPathEnabled(bool enabled);
+  bool isSimpleStackFastPathEnabled() const;
+
   void setExperimentalFeatureEnabled(ExperimentalFeature feature, bool enabled);
   bool isExperimentalFeatureEnabled(ExperimentalFeature feature) const;
   ExperimentalFeatureSet getEnabledExperiments() const;
@@ -66,13 +72,18 @@ class YG_EXPORT Config : public ::YGConfig {
   YGNodeRef
   cloneNode(YGNodeConstRef node, YGNodeConstRef owner, size_t childIndex) const;
 
+  void setLayoutCompleteCallback(YGLayoutCompleteFunc layoutComplete);
+  void notifyLayoutComplete(YGNodeConstRef node) const;
+
   static const Config& getDefault();
 
  private:
   YGCloneNodeFunc cloneNodeCallback_{nullptr};
+  YGLayoutCompleteFunc layoutCompleteCallback_{nullptr};
   YGLogger logger_{};
 
   bool useWebDefaults_ : 1 = false;
+  bool simpleStackFastPathEnabled_ : 1 = true;
 
   uint32_t version_ = 0;
   ExperimentalFeatureSet experimentalFeatures_{};
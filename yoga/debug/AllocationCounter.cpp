@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <yoga/debug/AllocationCounter.h>
+
+namespace facebook::yoga {
+
+AllocationCounts& threadAllocationCounts() {
+  thread_local AllocationCounts counts;
+  return counts;
+}
+
+} // namespace facebook::yoga
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace facebook::yoga {
+
+// Whether heap allocations made by Yoga are counted. Builds which define
+// YG_COUNT_ALLOCATIONS report them in LayoutData, at the cost of a thread
+// local update per allocation.
+#ifdef YG_COUNT_ALLOCATIONS
+constexpr bool kCountAllocations = true;
+#else
+constexpr bool kCountAllocations = false;
+#endif
+
+struct AllocationCounts {
+  uint64_t allocations = 0;
+  uint64_t bytes = 0;
+};
+
+// The allocations counted on the calling thread so far
+AllocationCounts& threadAllocationCounts();
+
+inline void countAllocation(size_t bytes) {
+  if constexpr (kCountAllocations) {
+    auto& counts = threadAllocationCounts();
+    counts.allocations++;
+    counts.bytes += bytes;
+  }
+}
+
+// Allocates like std::allocator, counting the allocations made
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+
+  CountingAllocator() = default;
+
+  // Containers rebind allocators to the types of their nodes
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>& /*other*/) noexcept {}
+
+  T* allocate(size_t n) {
+    countAllocation(n * sizeof(T));
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T* p, size_t n) noexcept {
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(const CountingAllocator<U>& /*other*/) const noexcept {
+    return true;
+  }
+};
+
+} // namespace facebook::yoga
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// @generated by enums.py
+// clang-format off
+#pragma once
+
+#include <cstdint>
+#include <yoga/YGEnums.h>
+#include <yoga/enums/YogaEnums.h>
+
+namespace facebook::yoga {
+
+enum class StyleChange : uint8_t {
+  None = YGStyleChangeNone,
+  LayoutUnaffected = YGStyleChangeLayoutUnaffected,
+  Layout = YGStyleChangeLayout,
+};
+
+template <>
+constexpr int32_t ordinalCount<StyleChange>() {
+  return 3;
+}
+
+constexpr StyleChange scopedEnum(YGStyleChange unscoped) {
+  return static_cast<StyleChange>(unscoped);
+}
+
+constexpr YGStyleChange unscopedEnum(StyleChange scoped) {
+  return static_cast<YGStyleChange>(scoped);
+}
+
+inline const char* toString(StyleChange e) {
+  return YGStyleChangeToString(unscopedEnum(e));
+}
+
+} // namespace facebook::yoga
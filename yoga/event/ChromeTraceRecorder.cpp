@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#include <yoga/event/ChromeTraceRecorder.h>
+
+namespace facebook::yoga {
+
+using namespace std::chrono;
+
+struct ChromeTraceRecorder::Recording {
+  struct Entry {
+    Event::Type type;
+    uint16_t thread;
+    YGNodeConstRef node;
+    steady_clock::duration time;
+    // What the event reports, depending on its type: the reason for a node
+    // visit or measure callback, what a node visit did, the size measured by
+    // a measure callback, or the visits counted by a layout pass
+    LayoutPassReason reason{};
+    LayoutType layoutType{};
+    std::array<float, 2> measuredSize{};
+    std::array<int, 6> counts{};
+  };
+
+  // The entries recorded by a single thread
+  struct Thread {
+    explicit Thread(uint16_t number) : number{number} {}
+
+    const uint16_t number;
+    std::mutex mutex;
+    std::vector<Entry> entries;
+  };
+
+  const steady_clock::time_point start = steady_clock::now();
+  PerThread<Thread> threads{
+      [](uint16_t number) { return std::make_unique<Thread>(number); }};
+
+  void record(YGNodeConstRef node, Event::Type type, const Event::Data& data);
+
+  // The entries of every thread, in the order they were recorded
+  std::vector<Entry> entries();
+};
+
+void ChromeTraceRecorder::Recording::record(
+    YGNodeConstRef node,
+    Event::Type type,
+    const Event::Data& data) {
+  const auto now = steady_clock::now();
+  Thread& thread = threads.local();
+
+  Entry entry{type, thread.number, node, now - start};
+  switch (type) {
+    case Event::NodeLayoutStart:
+      entry.reason = data.get<Event::NodeLayoutStart>().reason;
+      break;
+    case Event::NodeLayout:
+      entry.reason = data.get<Event::NodeLayout>().reason;
+      entry.layoutType = data.get<Event::NodeLayout>().layoutType;
+      break;
+    case Event::MeasureCallbackEnd: {
+      const auto& measure = data.get<Event::MeasureCallbackEnd>();
+      entry.reason = measure.reason;
+      entry.measuredSize = {measure.measuredWidth, measure.measuredHeight};
+      break;
+    }
+    case Event::LayoutPassEnd: {
+      const auto& layoutData = *data.get<Event::LayoutPassEnd>().layoutData;
+      entry.counts = {
+          layoutData.layouts,
+          layoutData.measures,
+          layoutData.cachedLayouts,
+          layoutData.cachedMeasures,
+          layoutData.measureCallbacks,
+          layoutData.measureCacheEvictions};
+      break;
+    }
+    default:
+      break;
+  }
+
+  std::scoped_lock lock{thread.mutex};
+  thread.entries.push_back(entry);
+}
+
+std::vector<ChromeTraceRecorder::Recording::Entry>
+ChromeTraceRecorder::Recording::entries() {
+  std::vector<Entry> entries;
+  threads.forEach([&](Thread& thread) {
+    std::scoped_lock lock{thread.mutex};
+    entries.insert(entries.end(), thread.entries.begin(), thread.entries.end());
+  });
+  std::stable_sort(
+      entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.time < b.time;
+      });
+  return entries;
+}
+
+ChromeTraceRecorder::ChromeTraceRecorder() : recording_{eventTypes} {}
+
+ChromeTraceRecorder::~ChromeTraceRecorder() = default;
+
+size_t ChromeTraceRecorder::size() const {
+  size_t size = 0;
+  recording_->threads.forEach([&](Recording::Thread& thread) {
+    std::scoped_lock lock{thread.mutex};
+    size += thread.entries.size();
+  });
+  return size;
+}
+
+void ChromeTraceRecorder::clear() {
+  recording_->threads.forEach([](Recording::Thread& thread) {
+    std::scoped_lock lock{thread.mutex};
+    thread.entries.clear();
+  });
+}
+
+static const char* layoutTypeToString(LayoutType layoutType) {
+  switch (layoutType) {
+    case LayoutType::kLayout:
+      return "layout";
+    case LayoutType::kMeasure:
+      return "measure";
+    case LayoutType::kCachedLayout:
+      return "cached_layout";
+    case LayoutType::kCachedMeasure:
+      return "cached_measure";
+  }
+  return "unknown";
+}
+
+// Whether the event starts a span, rather than ending one
+static bool startsSpan(Event::Type type) {
+  return type == Event::LayoutPassStart || type == Event::NodeLayoutStart ||
+      type == Event::MeasureCallbackStart || type == Event::NodeBaselineStart;
+}
+
+static const char* spanName(Event::Type type, LayoutPassReason reason) {
+  switch (type) {
+    case Event::LayoutPassStart:
+    case Event::LayoutPassEnd:
+      return "layout_pass";
+    case Event::NodeLayoutStart:
+    case Event::NodeLayout:
+      return LayoutPassReasonToString(reason);
+    case Event::MeasureCallbackStart:
+    case Event::MeasureCallbackEnd:
+      return "measure_callback";
+    default:
+      return "baseline_callback";
+  }
+}
+
+// JSON has no representation of NaN or infinity
+static std::array<char, 32> jsonNumber(float value) {
+  std::array<char, 32> text{};
+  if (std::isfinite(value)) {
+    std::snprintf(text.data(), text.size(), "%g", static_cast<double>(value));
+  } else {
+    std::snprintf(text.data(), text.size(), "null");
+  }
+  return text;
+}
+
+void ChromeTraceRecorder::writeChromeTrace(std::ostream& out) const {
+  // Chrome traces are timed in microseconds
+  std::array<char, 512> line{};
+  out << "{\"traceEvents\":[";
+  bool first = true;
+  for (const auto& entry : recording_->entries()) {
+    const auto microseconds =
+        duration<double, std::micro>(entry.time).count();
+    int length = std::snprintf(
+        line.data(),
+        line.size(),
+        "%s\n{\"name\":\"%s\",\"cat\":\"yoga\",\"ph\":\"%c\",\"ts\":%.3f,"
+        "\"pid\":1,\"tid\":%u,\"args\":{\"node\":\"%p\"",
+        first ? "" : ",",
+        spanName(entry.type, entry.reason),
+        startsSpan(entry.type) ? 'B' : 'E',
+        microseconds,
+        static_cast<unsigned>(entry.thread),
+        static_cast<const void*>(entry.node));
+    out.write(line.data(), length);
+    first = false;
+
+    switch (entry.type) {
+      case Event::NodeLayout:
+        length = std::snprintf(
+            line.data(),
+            line.size(),
+            ",\"layout_type\":\"%s\"",
+            layoutTypeToString(entry.layoutType));
+        break;
+      case Event::MeasureCallbackEnd:
+        length = std::snprintf(
+            line.data(),
+            line.size(),
+            ",\"reason\":\"%s\",\"measured_width\":%s,"
+            "\"measured_height\":%s",
+            LayoutPassReasonToString(entry.reason),
+            jsonNumber(entry.measuredSize[0]).data(),
+            jsonNumber(entry.measuredSize[1]).data());
+        break;
+      case Event::LayoutPassEnd:
+        length = std::snprintf(
+            line.data(),
+            line.size(),
+            ",\"layouts\":%d,\"measures\":%d,\"cached_layouts\":%d,"
+            "\"cached_measures\":%d,\"measure_callbacks\":%d,"
+            "\"measure_cache_evictions\":%d",
+            entry.counts[0],
+            entry.counts[1],
+            entry.counts[2],
+            entry.counts[3],
+            entry.counts[4],
+            entry.counts[5]);
+        break;
+      default:
+        length = 0;
+        break;
+    }
+    out.write(line.data(), length);
+    out << "}}";
+  }
+  out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+} // namespace facebook::yoga
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+#include <yoga/Yoga.h>
+
+#include <yoga/event/EventRecording.h>
+#include <yoga/event/event.h>
+
+namespace facebook::yoga {
+
+// Records layout passes, node visits, measure callbacks and baseline callbacks
+// as timestamped spans, which can be written out in the Chrome trace event
+// format and opened in Perfetto or chrome://tracing. Node visits are named
+// after the reason for the visit.
+//
+// Builds defining YG_DISABLE_EVENTS publish no events, so their traces stay
+// empty.
+class YG_EXPORT ChromeTraceRecorder {
+ public:
+  static constexpr Event::TypeMask eventTypes = Event::typeMask<
+      Event::LayoutPassStart,
+      Event::LayoutPassEnd,
+      Event::NodeLayoutStart,
+      Event::NodeLayout,
+      Event::MeasureCallbackStart,
+      Event::MeasureCallbackEnd,
+      Event::NodeBaselineStart,
+      Event::NodeBaselineEnd>();
+
+  ChromeTraceRecorder();
+  ~ChromeTraceRecorder();
+
+  ChromeTraceRecorder(const ChromeTraceRecorder&) = delete;
+  ChromeTraceRecorder& operator=(const ChromeTraceRecorder&) = delete;
+
+  // The number of span boundaries recorded, each of which starts or ends a
+  // span
+  size_t size() const;
+
+  void clear();
+
+  // Writes the spans recorded as a Chrome trace JSON document
+  void writeChromeTrace(std::ostream& out) const;
+
+ private:
+  struct Recording;
+  EventRecording<Recording> recording_;
+};
+
+} // namespace facebook::yoga
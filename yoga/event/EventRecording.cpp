@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <yoga/event/EventRecording.h>
+
+namespace facebook::yoga::detail {
+
+namespace {
+
+struct ThreadValue {
+  uint64_t owner;
+  std::weak_ptr<const void> alive;
+  void* value;
+};
+
+std::atomic<uint64_t> nextId{1};
+
+// Threads use few values at once, so a linear search is the fastest
+thread_local std::vector<ThreadValue> threadValues;
+
+} // namespace
+
+uint64_t nextPerThreadId() {
+  return nextId.fetch_add(1, std::memory_order_relaxed);
+}
+
+void* findThreadValue(uint64_t owner) {
+  for (const auto& threadValue : threadValues) {
+    if (threadValue.owner == owner) {
+      return threadValue.value;
+    }
+  }
+  return nullptr;
+}
+
+void cacheThreadValue(
+    uint64_t owner,
+    std::weak_ptr<const void> alive,
+    void* value) {
+  std::erase_if(threadValues, [](const ThreadValue& threadValue) {
+    return threadValue.alive.expired();
+  });
+  threadValues.push_back({owner, std::move(alive), value});
+}
+
+} // namespace facebook::yoga::detail
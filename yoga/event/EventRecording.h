@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <yoga/event/event.h>
+
+namespace facebook::yoga {
+
+// Subscribes to events of the given types for as long as it lives, and passes
+// them to `state.record(node, type, data)`. Publications which already started
+// on other threads may still hold the state when the recording is destroyed,
+// so it is shared with the subscriber, and records nothing once destroyed.
+template <typename State>
+class EventRecording {
+ public:
+  template <typename... Args>
+  explicit EventRecording(Event::TypeMask types, Args&&... args)
+      : shared_{std::make_shared<Shared>(std::forward<Args>(args)...)} {
+    subscription_ = Event::subscribe(
+        [shared = shared_](
+            YGNodeConstRef node, Event::Type type, Event::Data data) {
+          if (shared->active.load(std::memory_order_acquire)) {
+            shared->state.record(node, type, data);
+          }
+        },
+        types);
+  }
+
+  ~EventRecording() {
+    Event::unsubscribe(subscription_);
+    shared_->active.store(false, std::memory_order_release);
+  }
+
+  EventRecording(const EventRecording&) = delete;
+  EventRecording& operator=(const EventRecording&) = delete;
+
+  State& operator*() const {
+    return shared_->state;
+  }
+
+  State* operator->() const {
+    return &shared_->state;
+  }
+
+ private:
+  struct Shared {
+    template <typename... Args>
+    explicit Shared(Args&&... args) : state(std::forward<Args>(args)...) {}
+
+    std::atomic<bool> active{true};
+    State state;
+  };
+
+  std::shared_ptr<Shared> shared_;
+  Event::SubscriptionId subscription_;
+};
+
+namespace detail {
+
+// Each thread caches the values it uses, by the id of the PerThread owning
+// them. Ids are never reused, so a thread never mistakes a new owner for one
+// which was destroyed, and any number of owners can be used at once.
+uint64_t nextPerThreadId();
+void* findThreadValue(uint64_t owner);
+void cacheThreadValue(
+    uint64_t owner,
+    std::weak_ptr<const void> alive,
+    void* value);
+
+} // namespace detail
+
+// A value for each thread which uses it, created on first use. Looking up the
+// value of the calling thread takes no lock once created. Values outlive their
+// threads, so that what they recorded can still be read.
+template <typename T>
+class PerThread {
+ public:
+  // Creates the value of a thread, given its number: threads are numbered
+  // from 1 in the order they first use their value
+  using Factory = std::function<std::unique_ptr<T>(uint16_t thread)>;
+
+  explicit PerThread(
+      Factory factory = [](uint16_t) { return std::make_unique<T>(); })
+      : factory_{std::move(factory)} {}
+
+  PerThread(const PerThread&) = delete;
+  PerThread& operator=(const PerThread&) = delete;
+
+  // The value of the calling thread
+  T& local() {
+    if (void* value = detail::findThreadValue(id_)) {
+      return *static_cast<T*>(value);
+    }
+
+    T* value = nullptr;
+    {
+      std::scoped_lock lock{mutex_};
+      values_.push_back(factory_(static_cast<uint16_t>(values_.size() + 1)));
+      value = values_.back().get();
+    }
+    detail::cacheThreadValue(id_, alive_, value);
+    return *value;
+  }
+
+  // Calls `fn` with the value of every thread, in the order they were created.
+  // Threads may be using their values at the same time.
+  template <typename Fn>
+  void forEach(Fn&& fn) {
+    std::scoped_lock lock{mutex_};
+    for (auto& value : values_) {
+      fn(*value);
+    }
+  }
+
+ private:
+  const uint64_t id_ = detail::nextPerThreadId();
+  // Expires along with the values, so threads can drop them from their caches
+  const std::shared_ptr<const void> alive_ = std::make_shared<char>();
+  const Factory factory_;
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<T>> values_;
+};
+
+} // namespace facebook::yoga
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+#include <yoga/event/LayoutHotspotProfiler.h>
+
+namespace facebook::yoga {
+
+using namespace std::chrono;
+
+LayoutHotspot& LayoutHotspot::operator+=(const LayoutHotspot& other) {
+  visits += other.visits;
+  inclusiveTime += other.inclusiveTime;
+  selfTime += other.selfTime;
+  measureCallbacks += other.measureCallbacks;
+  measureCallbackTime += other.measureCallbackTime;
+  return *this;
+}
+
+static LayoutHotspot sum(const LayoutHotspotsByReason& byReason) {
+  LayoutHotspot total;
+  for (const auto& hotspot : byReason) {
+    total += hotspot;
+  }
+  return total;
+}
+
+struct LayoutHotspotProfiler::Profile {
+  // A node visit or measure callback which has not ended yet
+  struct Frame {
+    YGNodeConstRef node;
+    bool measureCallback;
+    LayoutPassReason reason;
+    steady_clock::time_point start;
+    // Time spent in the visits this visit made
+    nanoseconds childTime{};
+  };
+
+  // The profile of a single thread
+  struct Thread {
+    // The frames open on the thread, innermost last. Only the thread itself
+    // uses them.
+    std::vector<Frame> frames;
+    std::mutex mutex;
+    std::unordered_map<YGNodeConstRef, LayoutHotspotsByReason> nodes;
+  };
+
+  PerThread<Thread> threads;
+
+  // Ends the innermost frame if it was opened for the node, rather than
+  // before profiling started
+  static std::optional<Frame> popFrame(
+      std::vector<Frame>& frames,
+      YGNodeConstRef node,
+      bool measureCallback) {
+    if (frames.empty() || frames.back().node != node ||
+        frames.back().measureCallback != measureCallback) {
+      return std::nullopt;
+    }
+    Frame frame = frames.back();
+    frames.pop_back();
+    return frame;
+  }
+
+  void record(YGNodeConstRef node, Event::Type type, const Event::Data& data);
+
+  // The profiles of every thread, added up by node
+  std::unordered_map<YGNodeConstRef, LayoutHotspotsByReason> nodes();
+};
+
+void LayoutHotspotProfiler::Profile::record(
+    YGNodeConstRef node,
+    Event::Type type,
+    const Event::Data& data) {
+  const auto now = steady_clock::now();
+  if (type == Event::NodeDeallocation) {
+    threads.forEach([&](Thread& thread) {
+      std::scoped_lock lock{thread.mutex};
+      thread.nodes.erase(node);
+    });
+    return;
+  }
+
+  Thread& thread = threads.local();
+  auto& frames = thread.frames;
+  switch (type) {
+    case Event::NodeLayoutStart:
+      frames.push_back(
+          {node, false, data.get<Event::NodeLayoutStart>().reason, now});
+      break;
+    case Event::MeasureCallbackStart:
+      frames.push_back({node, true, LayoutPassReason{}, now});
+      break;
+    case Event::NodeLayout: {
+      const auto frame = popFrame(frames, node, false);
+      if (!frame) {
+        break;
+      }
+      const auto time = duration_cast<nanoseconds>(now - frame->start);
+      if (!frames.empty()) {
+        frames.back().childTime += time;
+      }
+      std::scoped_lock lock{thread.mutex};
+      auto& hotspot = thread.nodes[node][static_cast<size_t>(frame->reason)];
+      hotspot.visits++;
+      hotspot.inclusiveTime += time;
+      hotspot.selfTime += time - frame->childTime;
+      break;
+    }
+    case Event::MeasureCallbackEnd: {
+      const auto frame = popFrame(frames, node, true);
+      if (!frame) {
+        break;
+      }
+      const auto reason = data.get<Event::MeasureCallbackEnd>().reason;
+      std::scoped_lock lock{thread.mutex};
+      auto& hotspot = thread.nodes[node][static_cast<size_t>(reason)];
+      hotspot.measureCallbacks++;
+      hotspot.measureCallbackTime +=
+          duration_cast<nanoseconds>(now - frame->start);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+std::unordered_map<YGNodeConstRef, LayoutHotspotsByReason>
+LayoutHotspotProfiler::Profile::nodes() {
+  std::unordered_map<YGNodeConstRef, LayoutHotspotsByReason> nodes;
+  threads.forEach([&](Thread& thread) {
+    std::scoped_lock lock{thread.mutex};
+    for (const auto& [node, byReason] : thread.nodes) {
+      auto& total = nodes[node];
+      for (size_t i = 0; i < total.size(); i++) {
+        total[i] += byReason[i];
+      }
+    }
+  });
+  return nodes;
+}
+
+LayoutHotspotProfiler::LayoutHotspotProfiler() : profile_{eventTypes} {}
+
+LayoutHotspotProfiler::~LayoutHotspotProfiler() = default;
+
+std::vector<NodeLayoutHotspot> LayoutHotspotProfiler::costliestSubtrees(
+    size_t count) const {
+  const auto nodes = profile_->nodes();
+  std::vector<NodeLayoutHotspot> subtrees;
+  subtrees.reserve(nodes.size());
+  for (const auto& [node, byReason] : nodes) {
+    subtrees.push_back({node, sum(byReason), byReason});
+  }
+
+  const auto costlier = [](const auto& a, const auto& b) {
+    return a.total.inclusiveTime > b.total.inclusiveTime;
+  };
+  count = std::min(count, subtrees.size());
+  std::partial_sort(
+      subtrees.begin(), subtrees.begin() + count, subtrees.end(), costlier);
+  subtrees.resize(count);
+  return subtrees;
+}
+
+LayoutHotspotsByReason LayoutHotspotProfiler::reasons() const {
+  LayoutHotspotsByReason reasons{};
+  profile_->threads.forEach([&](Profile::Thread& thread) {
+    std::scoped_lock lock{thread.mutex};
+    for (const auto& [node, byReason] : thread.nodes) {
+      for (size_t i = 0; i < reasons.size(); i++) {
+        reasons[i] += byReason[i];
+      }
+    }
+  });
+  for (auto& reason : reasons) {
+    reason.inclusiveTime = {};
+  }
+  return reasons;
+}
+
+void LayoutHotspotProfiler::clear() {
+  profile_->threads.forEach([](Profile::Thread& thread) {
+    std::scoped_lock lock{thread.mutex};
+    thread.nodes.clear();
+  });
+}
+
+static double microseconds(nanoseconds time) {
+  return duration<double, std::micro>(time).count();
+}
+
+static void writeRow(
+    std::ostream& out,
+    const char* name,
+    const LayoutHotspot& hotspot,
+    const char* topReason) {
+  std::array<char, 256> line{};
+  const int length = std::snprintf(
+      line.data(),
+      line.size(),
+      "%-20s %8u %14.3f %12.3f %9u %12.3f%s%s\n",
+      name,
+      hotspot.visits,
+      microseconds(hotspot.inclusiveTime),
+      microseconds(hotspot.selfTime),
+      hotspot.measureCallbacks,
+      microseconds(hotspot.measureCallbackTime),
+      *topReason != '\0' ? " " : "",
+      topReason);
+  out.write(line.data(), length);
+}
+
+// Reasons leave out inclusive time, which they cannot add up
+static void writeReasonRow(
+    std::ostream& out,
+    const char* name,
+    const LayoutHotspot& hotspot) {
+  std::array<char, 256> line{};
+  const int length = std::snprintf(
+      line.data(),
+      line.size(),
+      "%-20s %8u %12.3f %9u %12.3f\n",
+      name,
+      hotspot.visits,
+      microseconds(hotspot.selfTime),
+      hotspot.measureCallbacks,
+      microseconds(hotspot.measureCallbackTime));
+  out.write(line.data(), length);
+}
+
+void LayoutHotspotProfiler::writeReport(std::ostream& out, size_t count)
+    const {
+  out << "Layout time by reason\n"
+      << "reason                 visits      self_us  measures   measure_us\n";
+  const auto byReason = reasons();
+  for (size_t i = 0; i < byReason.size(); i++) {
+    if (byReason[i].visits > 0 || byReason[i].measureCallbacks > 0) {
+      writeReasonRow(
+          out,
+          LayoutPassReasonToString(static_cast<LayoutPassReason>(i)),
+          byReason[i]);
+    }
+  }
+
+  out << "\nCostliest subtrees\n"
+      << "node                   visits   inclusive_us      self_us  measures"
+      << "   measure_us top_reason\n";
+  for (const auto& subtree : costliestSubtrees(count)) {
+    const auto topReason = std::max_element(
+        subtree.byReason.begin(),
+        subtree.byReason.end(),
+        [](const auto& a, const auto& b) {
+          return a.inclusiveTime < b.inclusiveTime;
+        });
+    std::array<char, 32> node{};
+    std::snprintf(
+        node.data(),
+        node.size(),
+        "%p",
+        static_cast<const void*>(subtree.node));
+    writeRow(
+        out,
+        node.data(),
+        subtree.total,
+        LayoutPassReasonToString(static_cast<LayoutPassReason>(
+            topReason - subtree.byReason.begin())));
+  }
+}
+
+} // namespace facebook::yoga
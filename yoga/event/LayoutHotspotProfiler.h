@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include <yoga/Yoga.h>
+
+#include <yoga/event/EventRecording.h>
+#include <yoga/event/event.h>
+
+namespace facebook::yoga {
+
+// The cost of node visits
+struct LayoutHotspot {
+  uint32_t visits = 0;
+  // Time spent in the visits, including the visits of descendants they made
+  std::chrono::nanoseconds inclusiveTime{};
+  // Time spent in the visits, excluding the visits of descendants
+  std::chrono::nanoseconds selfTime{};
+  // Measure callbacks made by the visits, whose time is part of self time
+  uint32_t measureCallbacks = 0;
+  std::chrono::nanoseconds measureCallbackTime{};
+
+  LayoutHotspot& operator+=(const LayoutHotspot& other);
+};
+
+using LayoutHotspotsByReason = std::
+    array<LayoutHotspot, static_cast<uint8_t>(LayoutPassReason::COUNT)>;
+
+// The cost of the visits of a node, which is the cost of its subtree
+struct NodeLayoutHotspot {
+  YGNodeConstRef node;
+  LayoutHotspot total;
+  LayoutHotspotsByReason byReason;
+};
+
+// Attributes the time spent laying out to the nodes visited and to the
+// reasons for the visits, to explain which subtrees make layout slow and
+// why they were visited.
+//
+// Nodes are forgotten when they are freed. Builds defining YG_DISABLE_EVENTS
+// have no visits to time, and report nothing.
+class YG_EXPORT LayoutHotspotProfiler {
+ public:
+  static constexpr Event::TypeMask eventTypes = Event::typeMask<
+      Event::NodeDeallocation,
+      Event::NodeLayoutStart,
+      Event::NodeLayout,
+      Event::MeasureCallbackStart,
+      Event::MeasureCallbackEnd>();
+
+  LayoutHotspotProfiler();
+  ~LayoutHotspotProfiler();
+
+  LayoutHotspotProfiler(const LayoutHotspotProfiler&) = delete;
+  LayoutHotspotProfiler& operator=(const LayoutHotspotProfiler&) = delete;
+
+  // The `count` nodes with the most inclusive time, costliest first
+  std::vector<NodeLayoutHotspot> costliestSubtrees(size_t count) const;
+
+  // The cost of the visits of every node, by reason for the visits. Visits
+  // nest, so adding up their inclusive time would count nested visits more
+  // than once: it is left at zero.
+  LayoutHotspotsByReason reasons() const;
+
+  void clear();
+
+  // Writes a table of the cost by reason, followed by a table of the `count`
+  // costliest subtrees
+  void writeReport(std::ostream& out, size_t count = 10) const;
+
+ private:
+  struct Profile;
+  EventRecording<Profile> profile_;
+};
+
+} // namespace facebook::yoga
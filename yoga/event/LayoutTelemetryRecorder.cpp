@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <limits>
+
+#include <yoga/event/LayoutTelemetryRecorder.h>
+
+namespace facebook::yoga {
+
+using namespace std::chrono;
+
+namespace {
+
+// The records of a single thread. Only that thread writes them, but any
+// thread may read them, so slots are written like a sequence lock: a reader
+// drops the records whose slots were claimed by a newer write while it was
+// copying them.
+class Ring {
+ public:
+  Ring(size_t capacity, uint16_t thread)
+      : slots_(capacity), mask_{capacity - 1}, thread_{thread} {}
+
+  void write(const LayoutTelemetryRecord& record) {
+    const uint64_t index = written_.load(std::memory_order_relaxed);
+    claimed_.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto& slot = slots_[index & mask_];
+    slot[0].store(
+        reinterpret_cast<uintptr_t>(record.node), std::memory_order_relaxed);
+    slot[1].store(
+        static_cast<uint64_t>(record.end.count()) |
+            (static_cast<uint64_t>(record.layoutType) << 56),
+        std::memory_order_relaxed);
+    slot[2].store(
+        static_cast<uint64_t>(record.duration.count()) |
+            (uint64_t{thread_} << 32) |
+            (static_cast<uint64_t>(record.type) << 48) |
+            (static_cast<uint64_t>(record.reason) << 56),
+        std::memory_order_relaxed);
+
+    written_.store(index + 1, std::memory_order_release);
+  }
+
+  void read(std::vector<LayoutTelemetryRecord>& records) const {
+    const uint64_t written = written_.load(std::memory_order_acquire);
+    const uint64_t first = oldestKept(written);
+
+    std::vector<std::array<uint64_t, 3>> copies;
+    copies.reserve(written - first);
+    for (uint64_t i = first; i < written; i++) {
+      const auto& slot = slots_[i & mask_];
+      copies.push_back(
+          {slot[0].load(std::memory_order_relaxed),
+           slot[1].load(std::memory_order_relaxed),
+           slot[2].load(std::memory_order_relaxed)});
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t claimed = claimed_.load(std::memory_order_relaxed);
+    const uint64_t firstIntact = std::max(first, oldestKept(claimed));
+
+    for (uint64_t i = firstIntact; i < written; i++) {
+      const auto& copy = copies[i - first];
+      records.push_back(
+          {reinterpret_cast<YGNodeConstRef>(copy[0]),
+           nanoseconds{copy[1] & kEndMask},
+           nanoseconds{copy[2] & 0xffffffff},
+           static_cast<uint16_t>(copy[2] >> 32),
+           static_cast<Event::Type>((copy[2] >> 48) & 0xff),
+           static_cast<LayoutPassReason>(copy[2] >> 56),
+           static_cast<LayoutType>(copy[1] >> 56)});
+    }
+  }
+
+  // Start times of the spans open on the thread, innermost last. Spans nested
+  // deeper than the array holds are only counted.
+  std::array<nanoseconds, LayoutTelemetryRecorder::kMaxTimedDepth> openSpans{};
+  size_t openSpanCount = 0;
+
+ private:
+  static constexpr uint64_t kEndMask = (uint64_t{1} << 56) - 1;
+
+  // The index of the oldest record still kept once `count` were written
+  uint64_t oldestKept(uint64_t count) const {
+    return count > slots_.size() ? count - slots_.size() : 0;
+  }
+
+  std::vector<std::array<std::atomic<uint64_t>, 3>> slots_;
+  const uint64_t mask_;
+  const uint16_t thread_;
+  std::atomic<uint64_t> claimed_{0};
+  std::atomic<uint64_t> written_{0};
+};
+
+} // namespace
+
+struct LayoutTelemetryRecorder::State {
+  const steady_clock::time_point start = steady_clock::now();
+  const size_t capacity;
+  const nanoseconds slowPassThreshold;
+  const SlowPassHandler slowPassHandler;
+  PerThread<Ring> rings{[this](uint16_t thread) {
+    return std::make_unique<Ring>(capacity, thread);
+  }};
+
+  State(
+      size_t capacity,
+      nanoseconds slowPassThreshold,
+      SlowPassHandler slowPassHandler)
+      : capacity{std::bit_ceil(std::max<size_t>(capacity, 1))},
+        slowPassThreshold{slowPassThreshold},
+        slowPassHandler{std::move(slowPassHandler)} {}
+
+  std::vector<LayoutTelemetryRecord> records() {
+    std::vector<LayoutTelemetryRecord> records;
+    rings.forEach([&](const Ring& ring) { ring.read(records); });
+    std::stable_sort(
+        records.begin(), records.end(), [](const auto& a, const auto& b) {
+          return a.end < b.end;
+        });
+    return records;
+  }
+
+  void record(YGNodeConstRef node, Event::Type type, const Event::Data& data) {
+    const auto now = duration_cast<nanoseconds>(steady_clock::now() - start);
+    Ring& ring = rings.local();
+    switch (type) {
+      case Event::LayoutPassStart:
+      case Event::NodeLayoutStart:
+      case Event::MeasureCallbackStart:
+      case Event::NodeBaselineStart:
+        if (ring.openSpanCount < ring.openSpans.size()) {
+          ring.openSpans[ring.openSpanCount] = now;
+        }
+        ring.openSpanCount++;
+        return;
+      default:
+        break;
+    }
+
+    LayoutTelemetryRecord record{
+        node, now, {}, 0, type, LayoutPassReason::kInitial, LayoutType{}};
+    if (ring.openSpanCount > 0) {
+      ring.openSpanCount--;
+      if (ring.openSpanCount < ring.openSpans.size()) {
+        constexpr nanoseconds longest{std::numeric_limits<uint32_t>::max()};
+        record.duration =
+            std::min(now - ring.openSpans[ring.openSpanCount], longest);
+      }
+    }
+    if (type == Event::NodeLayout) {
+      record.reason = data.get<Event::NodeLayout>().reason;
+      record.layoutType = data.get<Event::NodeLayout>().layoutType;
+    } else if (type == Event::MeasureCallbackEnd) {
+      record.reason = data.get<Event::MeasureCallbackEnd>().reason;
+    }
+    ring.write(record);
+
+    if (type == Event::LayoutPassEnd && slowPassHandler &&
+        record.duration >= slowPassThreshold) {
+      slowPassHandler(records());
+    }
+  }
+};
+
+LayoutTelemetryRecorder::LayoutTelemetryRecorder(
+    size_t capacity,
+    nanoseconds slowPassThreshold,
+    SlowPassHandler slowPassHandler)
+    : state_{
+          eventTypes,
+          capacity,
+          slowPassThreshold,
+          std::move(slowPassHandler)} {}
+
+LayoutTelemetryRecorder::~LayoutTelemetryRecorder() = default;
+
+std::vector<LayoutTelemetryRecord> LayoutTelemetryRecorder::records() const {
+  return state_->records();
+}
+
+} // namespace facebook::yoga
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <yoga/Yoga.h>
+
+#include <yoga/event/EventRecording.h>
+#include <yoga/event/event.h>
+
+namespace facebook::yoga {
+
+// A span of layout work which ended: a layout pass, a node visit, a measure
+// callback or a baseline callback
+struct LayoutTelemetryRecord {
+  YGNodeConstRef node;
+  // When the span ended, since the recorder was created
+  std::chrono::nanoseconds end;
+  // Zero for spans nested too deeply in other spans to be timed
+  std::chrono::nanoseconds duration;
+  // Small ids of the threads which recorded spans, starting at 1
+  uint16_t thread;
+  // The event which ended the span
+  Event::Type type;
+  // The reason for node visits and measure callbacks
+  LayoutPassReason reason;
+  // Whether node visits laid out or measured the node, and whether that came
+  // from the cache
+  LayoutType layoutType;
+};
+
+// Keeps the most recent spans of layout work of every thread, cheaply enough to
+// stay enabled in production, so they can be looked at when a layout pass was
+// slow.
+//
+// Each thread writes fixed-size records into a ring buffer of its own, without
+// locks. Only the first event a thread publishes takes a lock, to create its
+// buffer. Records can be read from any thread while layout runs. With
+// YG_DISABLE_EVENTS defined, layout publishes nothing and the buffers stay
+// empty.
+class YG_EXPORT LayoutTelemetryRecorder {
+ public:
+  using SlowPassHandler =
+      std::function<void(std::vector<LayoutTelemetryRecord> records)>;
+
+  static constexpr Event::TypeMask eventTypes = Event::typeMask<
+      Event::LayoutPassStart,
+      Event::LayoutPassEnd,
+      Event::NodeLayoutStart,
+      Event::NodeLayout,
+      Event::MeasureCallbackStart,
+      Event::MeasureCallbackEnd,
+      Event::NodeBaselineStart,
+      Event::NodeBaselineEnd>();
+
+  // How deeply spans may be nested in other spans of the same thread to be
+  // timed. The start of every span is kept until it ends, in a fixed array so
+  // that recording never allocates.
+  static constexpr size_t kMaxTimedDepth = 256;
+
+  // Keeps the last `capacity` records of each thread, rounded up to a power
+  // of two. When a layout pass takes at least `slowPassThreshold`, the
+  // handler is called on the thread which ran it with the records of every
+  // thread.
+  explicit LayoutTelemetryRecorder(
+      size_t capacity = 4096,
+      std::chrono::nanoseconds slowPassThreshold = {},
+      SlowPassHandler slowPassHandler = {});
+  ~LayoutTelemetryRecorder();
+
+  LayoutTelemetryRecorder(const LayoutTelemetryRecorder&) = delete;
+  LayoutTelemetryRecorder& operator=(const LayoutTelemetryRecorder&) = delete;
+
+  // The records currently kept for every thread, in the order the spans ended
+  std::vector<LayoutTelemetryRecord> records() const;
+
+ private:
+  struct State;
+  EventRecording<State> state_;
+};
+
+} // namespace facebook::yoga
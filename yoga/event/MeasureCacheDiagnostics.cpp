@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+#include <yoga/event/MeasureCacheDiagnostics.h>
+
+namespace facebook::yoga {
+
+using NodeStatistics =
+    std::unordered_map<YGNodeConstRef, MeasureCacheStatistics>;
+
+static void add(
+    MeasureCacheStatistics& total,
+    const MeasureCacheStatistics& statistics) {
+  total.lookups += statistics.lookups;
+  total.layoutCacheHits += statistics.layoutCacheHits;
+  for (size_t i = 0; i < total.measurementCacheHits.size(); i++) {
+    total.measurementCacheHits[i] += statistics.measurementCacheHits[i];
+  }
+  total.misses += statistics.misses;
+  total.evictions += statistics.evictions;
+  total.invalidations += statistics.invalidations;
+}
+
+struct MeasureCacheDiagnostics::State {
+  // The statistics gathered by a single thread
+  struct Thread {
+    std::mutex mutex;
+    NodeStatistics nodes;
+  };
+
+  PerThread<Thread> threads;
+
+  void record(YGNodeConstRef node, Event::Type type, const Event::Data& data) {
+    if (type == Event::NodeDeallocation) {
+      threads.forEach([&](Thread& thread) {
+        std::scoped_lock lock{thread.mutex};
+        thread.nodes.erase(node);
+      });
+      return;
+    }
+
+    const auto& visit = data.get<Event::NodeLayout>();
+    Thread& thread = threads.local();
+    std::scoped_lock lock{thread.mutex};
+    auto& statistics = thread.nodes[node];
+    statistics.lookups++;
+    if (visit.cacheSlot >= 0) {
+      statistics.measurementCacheHits[static_cast<size_t>(visit.cacheSlot)]++;
+    } else if (visit.layoutType == LayoutType::kCachedLayout ||
+               visit.layoutType == LayoutType::kCachedMeasure) {
+      statistics.layoutCacheHits++;
+    } else {
+      statistics.misses++;
+    }
+    statistics.evictions += visit.cacheEvicted ? 1 : 0;
+    statistics.invalidations += visit.cacheInvalidated ? 1 : 0;
+  }
+
+  // The statistics of every thread, added up by node
+  NodeStatistics nodes() {
+    NodeStatistics nodes;
+    threads.forEach([&](Thread& thread) {
+      std::scoped_lock lock{thread.mutex};
+      for (const auto& [node, statistics] : thread.nodes) {
+        add(nodes[node], statistics);
+      }
+    });
+    return nodes;
+  }
+};
+
+MeasureCacheDiagnostics::MeasureCacheDiagnostics() : state_{eventTypes} {}
+
+MeasureCacheDiagnostics::~MeasureCacheDiagnostics() = default;
+
+std::optional<MeasureCacheStatistics> MeasureCacheDiagnostics::statistics(
+    YGNodeConstRef node) const {
+  std::optional<MeasureCacheStatistics> result;
+  state_->threads.forEach([&](State::Thread& thread) {
+    std::scoped_lock lock{thread.mutex};
+    const auto it = thread.nodes.find(node);
+    if (it != thread.nodes.end()) {
+      add(result ? *result : result.emplace(), it->second);
+    }
+  });
+  return result;
+}
+
+std::vector<std::pair<YGNodeConstRef, MeasureCacheStatistics>>
+MeasureCacheDiagnostics::thrashingNodes(uint32_t minEvictions) const {
+  std::vector<std::pair<YGNodeConstRef, MeasureCacheStatistics>> result;
+  for (const auto& entry : state_->nodes()) {
+    if (entry.second.evictions >= std::max<uint32_t>(minEvictions, 1)) {
+      result.push_back(entry);
+    }
+  }
+  std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+    return a.second.evictions > b.second.evictions;
+  });
+  return result;
+}
+
+void MeasureCacheDiagnostics::clear() {
+  state_->threads.forEach([](State::Thread& thread) {
+    std::scoped_lock lock{thread.mutex};
+    thread.nodes.clear();
+  });
+}
+
+} // namespace facebook::yoga
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <yoga/Yoga.h>
+
+#include <yoga/event/EventRecording.h>
+#include <yoga/event/event.h>
+#include <yoga/node/LayoutResults.h>
+
+namespace facebook::yoga {
+
+// How the layout and measurement caches of a node were used
+struct MeasureCacheStatistics {
+  // Every visit of the node looks its results up in the caches
+  uint32_t lookups = 0;
+  uint32_t layoutCacheHits = 0;
+  std::array<uint32_t, LayoutResults::MaxCachedMeasurements>
+      measurementCacheHits = {};
+  uint32_t misses = 0;
+  // Times the measurement cache was full and wrapped around, discarding
+  // every measurement it held
+  uint32_t evictions = 0;
+  // Times the cached results were discarded because the node was dirty, or
+  // its config or owner direction changed
+  uint32_t invalidations = 0;
+};
+
+// Gathers statistics on the caches of every node laid out, to find the nodes
+// whose measurement caches thrash: typically text nodes measured under more
+// distinct constraints per pass than the cache holds.
+//
+// Statistics are dropped when their node is freed. The caches are only
+// observed through events, so builds defining YG_DISABLE_EVENTS gather none.
+class YG_EXPORT MeasureCacheDiagnostics {
+ public:
+  static constexpr Event::TypeMask eventTypes =
+      Event::typeMask<Event::NodeLayout, Event::NodeDeallocation>();
+
+  MeasureCacheDiagnostics();
+  ~MeasureCacheDiagnostics();
+
+  MeasureCacheDiagnostics(const MeasureCacheDiagnostics&) = delete;
+  MeasureCacheDiagnostics& operator=(const MeasureCacheDiagnostics&) = delete;
+
+  // The statistics of the node, if it was laid out
+  std::optional<MeasureCacheStatistics> statistics(YGNodeConstRef node) const;
+
+  // The nodes whose measurement cache was evicted at least `minEvictions`
+  // times, most evicted first
+  std::vector<std::pair<YGNodeConstRef, MeasureCacheStatistics>>
+  thrashingNodes(uint32_t minEvictions = 1) const;
+
+  void clear();
+
+ private:
+  struct State;
+  EventRecording<State> state_;
+};
+
+} // namespace facebook::yoga
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <yoga/debug/Log.h>
+#include <yoga/event/RelayoutDetector.h>
+
+namespace facebook::yoga {
+
+static void logReport(const RelayoutReport& report) {
+  std::string chain;
+  for (const auto& step : report.chain) {
+    if (!chain.empty()) {
+      chain += " > ";
+    }
+    chain += LayoutPassReasonToString(step.reason);
+  }
+  yoga::log(
+      resolveRef(report.node),
+      LogLevel::Warn,
+      "Node %p was laid out %u times in one layout pass, through: %s",
+      static_cast<const void*>(report.node),
+      report.visits,
+      chain.c_str());
+}
+
+struct RelayoutDetector::State {
+  struct NodeVisits {
+    uint32_t visits = 0;
+    std::array<uint32_t, static_cast<uint8_t>(LayoutPassReason::COUNT)>
+        visitsByReason = {};
+  };
+
+  // The layout pass running on a thread
+  struct Pass {
+    // The visits which have not ended yet, innermost last
+    std::vector<RelayoutStep> steps;
+    std::unordered_map<YGNodeConstRef, NodeVisits> nodes;
+  };
+
+  const uint32_t threshold;
+  const Handler handler;
+  // The passes running on each thread, innermost last: measure functions may
+  // lay out other trees. Only the thread itself uses them.
+  PerThread<std::vector<Pass>> threads;
+
+  State(uint32_t threshold, Handler handler)
+      : threshold{threshold}, handler{std::move(handler)} {}
+
+  void record(YGNodeConstRef node, Event::Type type, const Event::Data& data) {
+    if (const auto report = visit(threads.local(), node, type, data)) {
+      if (handler) {
+        handler(*report);
+      } else {
+        logReport(*report);
+      }
+    }
+  }
+
+  std::optional<RelayoutReport> visit(
+      std::vector<Pass>& passes,
+      YGNodeConstRef node,
+      Event::Type type,
+      const Event::Data& data) const {
+    if (type == Event::LayoutPassStart) {
+      passes.emplace_back();
+      return std::nullopt;
+    }
+    // Passes which started before detection did are not followed
+    if (passes.empty()) {
+      return std::nullopt;
+    }
+    Pass& pass = passes.back();
+    if (type == Event::LayoutPassEnd) {
+      passes.pop_back();
+      return std::nullopt;
+    }
+    if (type == Event::NodeLayoutStart) {
+      pass.steps.push_back({node, data.get<Event::NodeLayoutStart>().reason});
+      return std::nullopt;
+    }
+
+    if (pass.steps.empty()) {
+      return std::nullopt;
+    }
+    const auto& layout = data.get<Event::NodeLayout>();
+    if (layout.layoutType != LayoutType::kLayout &&
+        layout.layoutType != LayoutType::kMeasure) {
+      pass.steps.pop_back();
+      return std::nullopt;
+    }
+
+    auto& visits = pass.nodes[node];
+    visits.visits++;
+    visits.visitsByReason[static_cast<size_t>(layout.reason)]++;
+    std::optional<RelayoutReport> report;
+    if (visits.visits == threshold + 1) {
+      report = RelayoutReport{
+          node, visits.visits, visits.visitsByReason, pass.steps};
+    }
+    pass.steps.pop_back();
+    return report;
+  }
+};
+
+RelayoutDetector::RelayoutDetector(uint32_t threshold, Handler handler)
+    : state_{eventTypes, threshold, std::move(handler)} {}
+
+RelayoutDetector::~RelayoutDetector() = default;
+
+} // namespace facebook::yoga
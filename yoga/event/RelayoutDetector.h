@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <yoga/Yoga.h>
+
+#include <yoga/event/EventRecording.h>
+#include <yoga/event/event.h>
+
+namespace facebook::yoga {
+
+// A node visit, and the reason it was made
+struct RelayoutStep {
+  YGNodeConstRef node;
+  LayoutPassReason reason;
+};
+
+// A node which was laid out or measured more times in a layout pass than the
+// detector allows
+struct RelayoutReport {
+  YGNodeConstRef node;
+  // Visits of the node in the pass which were not served from the cache, so
+  // far
+  uint32_t visits;
+  std::array<uint32_t, static_cast<uint8_t>(LayoutPassReason::COUNT)>
+      visitsByReason;
+  // The visits which led to the visit exceeding the threshold, from the root
+  // of the pass to the node
+  std::vector<RelayoutStep> chain;
+};
+
+// Detects nodes laid out or measured many times in a single layout pass,
+// which makes layout super-linear in the size of the tree. Nested stretch,
+// multiline stretch and flex measure passes are the usual cause.
+//
+// Only visits which miss the cache are counted. Every node is reported at most
+// once per pass, on the visit which exceeds the threshold. Without a handler,
+// reports are logged as warnings through the logger of the config of the
+// node.
+//
+// Nothing is detected in builds defining YG_DISABLE_EVENTS.
+class YG_EXPORT RelayoutDetector {
+ public:
+  using Handler = std::function<void(const RelayoutReport& report)>;
+
+  static constexpr Event::TypeMask eventTypes = Event::typeMask<
+      Event::LayoutPassStart,
+      Event::LayoutPassEnd,
+      Event::NodeLayoutStart,
+      Event::NodeLayout>();
+
+  static constexpr uint32_t kDefaultThreshold = 16;
+
+  explicit RelayoutDetector(
+      uint32_t threshold = kDefaultThreshold,
+      Handler handler = {});
+  ~RelayoutDetector();
+
+  RelayoutDetector(const RelayoutDetector&) = delete;
+  RelayoutDetector& operator=(const RelayoutDetector&) = delete;
+
+ private:
+  struct State;
+  EventRecording<State> state_;
+};
+
+} // namespace facebook::yoga
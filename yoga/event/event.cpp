@@ -6,8 +6,13 @@
  */
 
 #include "event.h"
+#include <algorithm>
 #include <atomic>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 namespace facebook::yoga {
 
@@ -34,53 +39,236 @@ const char* LayoutPassReasonToString(const LayoutPassReason value) {
   }
 }
 
+const char* DirtyReasonToString(const DirtyReason value) {
+  switch (value) {
+    case DirtyReason::kStyleChange:
+      return "style_change";
+    case DirtyReason::kChildInsert:
+      return "child_insert";
+    case DirtyReason::kChildRemove:
+      return "child_remove";
+    case DirtyReason::kChildrenChange:
+      return "children_change";
+    case DirtyReason::kMeasureDirty:
+      return "measure_dirty";
+    case DirtyReason::kConfigChange:
+      return "config_change";
+    case DirtyReason::kNodeChange:
+      return "node_change";
+    default:
+      return "unknown";
+  }
+}
+
 namespace {
 
 struct Node {
   std::function<Event::Subscriber> subscriber = nullptr;
-  Node* next = nullptr;
+  Event::TypeMask types = 0;
+  Event::SubscriptionId id = 0;
+  std::atomic<Node*> next{nullptr};
+  // The epoch in which the node was unlinked, once it was
+  uint64_t retiredEpoch = 0;
 
-  explicit Node(std::function<Event::Subscriber>&& subscriber)
-      : subscriber{std::move(subscriber)} {}
+  Node(
+      std::function<Event::Subscriber>&& subscriber,
+      Event::TypeMask types,
+      Event::SubscriptionId id)
+      : subscriber{std::move(subscriber)}, types{types}, id{id} {}
 };
 
+// The epoch in which the publication in progress on a thread started, or 0
+// while the thread is not publishing. Only the thread itself writes it, and
+// it has a cache line of its own, so publications on different threads never
+// write to shared memory.
+struct alignas(64) PublisherSlot {
+  std::atomic<uint64_t> epoch{0};
+};
+
+// Publishing walks the list without locking. Changes to it are serialized by
+// the mutex, which also guards the state below which is not atomic. A node
+// unlinked in some epoch is only deleted once every publication which started
+// in an earlier one has ended, as those may still be walking through it.
+std::mutex subscribersMutex;
 std::atomic<Node*> subscribers{nullptr};
+std::atomic<uint64_t> epoch{1};
+std::vector<PublisherSlot*> publisherSlots;
+std::vector<Node*> retired;
+std::atomic<bool> hasRetired{false};
+Event::SubscriptionId lastSubscriptionId = 0;
+
+void retire(std::vector<Node*>& nodes) {
+  // Incremented after the nodes were unlinked, so publications which see the
+  // new epoch cannot reach them
+  const auto retiredEpoch = epoch.fetch_add(1) + 1;
+  for (auto node : nodes) {
+    node->retiredEpoch = retiredEpoch;
+    retired.push_back(node);
+  }
+  // Ordered before the checks of publications in progress which follow, so
+  // that either a check or the publication ending sees the nodes
+  hasRetired.store(true);
+}
 
-Node* push(Node* newHead) {
-  Node* oldHead = nullptr;
-  do {
-    oldHead = subscribers.load(std::memory_order_relaxed);
-    if (newHead != nullptr) {
-      newHead->next = oldHead;
+// Takes the retired nodes which no publication in progress can reach.
+std::vector<Node*> takeUnreachable() {
+  auto oldestPublication = std::numeric_limits<uint64_t>::max();
+  for (auto slot : publisherSlots) {
+    if (const auto publication = slot->epoch.load(); publication != 0) {
+      oldestPublication = std::min(oldestPublication, publication);
     }
-  } while (!subscribers.compare_exchange_weak(
-      oldHead, newHead, std::memory_order_release, std::memory_order_relaxed));
-  return oldHead;
+  }
+
+  std::vector<Node*> unreachable;
+  std::erase_if(retired, [&](Node* node) {
+    if (node->retiredEpoch > oldestPublication) {
+      return false;
+    }
+    unreachable.push_back(node);
+    return true;
+  });
+  hasRetired.store(!retired.empty());
+  return unreachable;
+}
+
+// Subscribers are destroyed outside of the lock, as they may own anything
+void deleteNodes(const std::vector<Node*>& nodes) {
+  for (auto node : nodes) {
+    delete node;
+  }
 }
 
+void deleteUnreachable() {
+  std::vector<Node*> unreachable;
+  {
+    std::scoped_lock lock{subscribersMutex};
+    unreachable = takeUnreachable();
+  }
+  deleteNodes(unreachable);
+}
+
+// Registers the slot of a thread on its first publication, and removes it
+// when the thread exits.
+struct Publisher {
+  PublisherSlot* slot = nullptr;
+  // Subscribers may cause publications themselves, which are covered by the
+  // outermost one
+  uint32_t depth = 0;
+
+  Publisher() {
+    std::scoped_lock lock{subscribersMutex};
+    slot = new PublisherSlot{};
+    publisherSlots.push_back(slot);
+  }
+
+  ~Publisher() {
+    std::scoped_lock lock{subscribersMutex};
+    std::erase(publisherSlots, slot);
+    delete slot;
+  }
+
+  Publisher(const Publisher&) = delete;
+  Publisher& operator=(const Publisher&) = delete;
+};
+
+// Marks the thread as publishing for as long as it lives
+class PublicationScope {
+ public:
+  PublicationScope() : publisher_{publisher()} {
+    if (publisher_.depth++ == 0) {
+      // Ordered before the loads of the list which follow
+      publisher_.slot->epoch.store(epoch.load());
+    }
+  }
+
+  ~PublicationScope() {
+    if (--publisher_.depth == 0) {
+      // Ordered before the check of retired nodes, so that either it or the
+      // unsubscription sees that the publication ended
+      publisher_.slot->epoch.store(0);
+      if (hasRetired.load()) {
+        deleteUnreachable();
+      }
+    }
+  }
+
+  PublicationScope(const PublicationScope&) = delete;
+  PublicationScope& operator=(const PublicationScope&) = delete;
+
+ private:
+  Publisher& publisher_;
+
+  static Publisher& publisher() {
+    thread_local Publisher publisher;
+    return publisher;
+  }
+};
+
 } // namespace
 
+std::atomic<Event::TypeMask> Event::subscribedTypes_{0};
+
 void Event::reset() {
-  auto head = push(nullptr);
-  while (head != nullptr) {
-    auto current = head;
-    head = head->next;
-    delete current;
+  std::vector<Node*> unreachable;
+  {
+    std::scoped_lock lock{subscribersMutex};
+    subscribedTypes_.store(0, std::memory_order_relaxed);
+    std::vector<Node*> unlinked;
+    for (auto head = subscribers.exchange(nullptr); head != nullptr;) {
+      unlinked.push_back(std::exchange(head, head->next.load()));
+    }
+    retire(unlinked);
+    unreachable = takeUnreachable();
   }
+  deleteNodes(unreachable);
 }
 
-void Event::subscribe(std::function<Subscriber>&& subscriber) {
-  push(new Node{std::move(subscriber)});
+Event::SubscriptionId Event::subscribe(
+    std::function<Subscriber>&& subscriber,
+    TypeMask types) {
+  std::scoped_lock lock{subscribersMutex};
+  auto node = new Node{std::move(subscriber), types, ++lastSubscriptionId};
+  node->next.store(subscribers.load(std::memory_order_relaxed));
+  subscribers.store(node);
+  subscribedTypes_.fetch_or(types, std::memory_order_relaxed);
+  return node->id;
+}
+
+void Event::unsubscribe(SubscriptionId subscription) {
+  std::vector<Node*> unreachable;
+  {
+    std::scoped_lock lock{subscribersMutex};
+    std::vector<Node*> unlinked;
+    TypeMask remainingTypes = 0;
+    for (auto link = &subscribers; auto node = link->load();) {
+      if (node->id == subscription) {
+        link->store(node->next.load());
+        unlinked.push_back(node);
+      } else {
+        remainingTypes |= node->types;
+        link = &node->next;
+      }
+    }
+    subscribedTypes_.store(remainingTypes, std::memory_order_relaxed);
+    if (unlinked.empty()) {
+      return;
+    }
+    retire(unlinked);
+    unreachable = takeUnreachable();
+  }
+  deleteNodes(unreachable);
 }
 
 void Event::publish(
     YGNodeConstRef node,
     Type eventType,
     const Data& eventData) {
-  for (auto subscriber = subscribers.load(std::memory_order_relaxed);
-       subscriber != nullptr;
-       subscriber = subscriber->next) {
-    subscriber->subscriber(node, eventType, eventData);
+  PublicationScope publication;
+  for (auto subscriber = subscribers.load(); subscriber != nullptr;
+       subscriber = subscriber->next.load(std::memory_order_acquire)) {
+    if ((subscriber->types & (TypeMask{1} << eventType)) != 0) {
+      subscriber->subscriber(node, eventType, eventData);
+    }
   }
 }
 
@@ -10,6 +10,7 @@
 #include <yoga/Yoga.h>
 
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <vector>
@@ -42,12 +43,31 @@ struct LayoutData {
   int cachedLayouts;
   int cachedMeasures;
   int measureCallbacks;
+  int measureCacheEvictions;
+  // Heap allocations made on the thread during the pass, which are only
+  // counted in builds defining YG_COUNT_ALLOCATIONS
+  uint64_t allocations;
+  uint64_t allocatedBytes;
   std::array<int, static_cast<uint8_t>(LayoutPassReason::COUNT)>
       measureCallbackReasonsCount;
 };
 
 const char* LayoutPassReasonToString(LayoutPassReason value);
 
+// What marked a node dirty
+enum struct DirtyReason : int {
+  kStyleChange = 0,
+  kChildInsert = 1,
+  kChildRemove = 2,
+  kChildrenChange = 3,
+  kMeasureDirty = 4,
+  kConfigChange = 5,
+  kNodeChange = 6,
+  COUNT
+};
+
+const char* DirtyReasonToString(DirtyReason value);
+
 struct YG_EXPORT Event {
   enum Type {
     NodeAllocation,
@@ -59,11 +79,24 @@ struct YG_EXPORT Event {
     MeasureCallbackEnd,
     NodeBaselineStart,
     NodeBaselineEnd,
+    NodeLayoutStart,
+    NodeDirtied,
   };
   class Data;
   using Subscriber = void(YGNodeConstRef, Type, Data);
   using Subscribers = std::vector<std::function<Subscriber>>;
 
+  // A set of event types, with a bit per type
+  using TypeMask = uint32_t;
+
+  template <Type... Types>
+  static constexpr TypeMask typeMask() {
+    return ((TypeMask{1} << Types) | ...);
+  }
+
+  static constexpr TypeMask allTypes =
+      (TypeMask{1} << (NodeDirtied + 1)) - 1;
+
   template <Type E>
   struct TypedData {};
 
@@ -80,16 +113,50 @@ struct YG_EXPORT Event {
     }
   };
 
+  // Whether events are published at all. Builds which never subscribe can
+  // define YG_DISABLE_EVENTS to compile every publication out.
+#ifdef YG_DISABLE_EVENTS
+  static constexpr bool enabled = false;
+#else
+  static constexpr bool enabled = true;
+#endif
+
+  // Identifies a subscription, so that it can be ended on its own
+  using SubscriptionId = uint64_t;
+
+  // Ends every subscription
   static void reset();
 
-  static void subscribe(std::function<Subscriber>&& subscriber);
+  // Subscribes to events of the types in the mask. Events of other types are
+  // not passed to the subscriber.
+  static SubscriptionId subscribe(
+      std::function<Subscriber>&& subscriber,
+      TypeMask types = allTypes);
+
+  // Ends a subscription, and releases its subscriber once no publication
+  // still running on another thread may call it. Subscriptions already ended
+  // by reset() are ignored.
+  static void unsubscribe(SubscriptionId subscription);
+
+  // Whether anything is subscribed to events of the given type. Publishing
+  // checks this inline, so costs a single load while nothing is subscribed.
+  static bool hasSubscribers(Type eventType) {
+    return (subscribedTypes_.load(std::memory_order_relaxed) &
+            (TypeMask{1} << eventType)) != 0;
+  }
 
   template <Type E>
   static void publish(YGNodeConstRef node, const TypedData<E>& eventData = {}) {
-    publish(node, E, Data{eventData});
+    if constexpr (enabled) {
+      if (hasSubscribers(E)) {
+        publish(node, E, Data{eventData});
+      }
+    }
   }
 
  private:
+  static std::atomic<TypeMask> subscribedTypes_;
+
   static void publish(
       YGNodeConstRef /*node*/,
       Type /*eventType*/,
@@ -125,6 +192,33 @@ struct Event::TypedData<Event::MeasureCallbackEnd> {
 template <>
 struct Event::TypedData<Event::NodeLayout> {
   LayoutType layoutType;
+  LayoutPassReason reason;
+  // The slot of the measurement cache the results came from, or -1 if they
+  // did not come from the measurement cache
+  int32_t cacheSlot;
+  // Whether the cached results of the node were discarded before the visit,
+  // because the node was dirty or its config or owner direction changed
+  bool cacheInvalidated;
+  // Whether storing the results wrapped the full measurement cache around,
+  // which discards every measurement it held
+  bool cacheEvicted;
+};
+
+template <>
+struct Event::TypedData<Event::NodeLayoutStart> {
+  LayoutPassReason reason;
+};
+
+// Published for the node a change marked dirty, once its ancestors were
+// marked dirty too. Nothing is published when the node was already dirty.
+template <>
+struct Event::TypedData<Event::NodeDirtied> {
+  DirtyReason reason;
+  // The ancestors marked dirty along with the node, up to the first which
+  // already was, or the root
+  uint32_t ancestorsDirtied;
+  // The furthest ancestor marked dirty, or the node itself
+  YGNodeConstRef topmostDirtied;
 };
 
 } // namespace facebook::yoga
@@ -38,6 +38,15 @@ struct LayoutResults {
 
   CachedMeasurement cachedLayout{};
 
+  // The result of the baseline function for the given measured size, during
+  // the layout pass with the given generation
+  struct CachedBaseline {
+    uint32_t generation = 0;
+    float width = YGUndefined;
+    float height = YGUndefined;
+    float baseline = YGUndefined;
+  } cachedBaseline{};
+
   Direction direction() const {
     return direction_;
   }
@@ -11,6 +11,7 @@
 #include <forward_list>
 #include <utility>
 
+#include <yoga/debug/AllocationCounter.h>
 #include <yoga/enums/Display.h>
 
 namespace facebook::yoga {
@@ -112,7 +113,10 @@ class LayoutableChildren {
 
     const T* node_{nullptr};
     size_t childIndex_{0};
-    std::forward_list<std::pair<const T*, size_t>> backtrack_;
+    std::forward_list<
+        std::pair<const T*, size_t>,
+        CountingAllocator<std::pair<const T*, size_t>>>
+        backtrack_;
 
     friend LayoutableChildren;
   };
@@ -10,6 +10,7 @@
 #include <iostream>
 
 #include <yoga/algorithm/FlexDirection.h>
+#include <yoga/debug/AllocationCounter.h>
 #include <yoga/debug/AssertFatal.h>
 #include <yoga/debug/Log.h>
 #include <yoga/node/Node.h>
@@ -17,15 +18,24 @@
 
 namespace facebook::yoga {
 
+const std::shared_ptr<Style>& Node::defaultStyle(const Config& config) {
+  static const auto style = std::make_shared<Style>();
+  static const auto webStyle = [] {
+    auto webStyle = std::make_shared<Style>();
+    webStyle->setFlexDirection(FlexDirection::Row);
+    webStyle->setAlignContent(Align::Stretch);
+    return webStyle;
+  }();
+  return config.useWebDefaults() ? webStyle : style;
+}
+
 Node::Node() : Node{&Config::getDefault()} {}
 
 Node::Node(const yoga::Config* config) : config_{config} {
   yoga::assertFatal(
       config != nullptr, "Attempting to construct Node with null config");
 
-  if (config->useWebDefaults()) {
-    useWebDefaults();
-  }
+  style_ = defaultStyle(*config);
 }
 
 Node::Node(Node&& node) noexcept
@@ -38,10 +48,12 @@ Node::Node(Node&& node) noexcept
       measureFunc_(node.measureFunc_),
       baselineFunc_(node.baselineFunc_),
       dirtiedFunc_(node.dirtiedFunc_),
-      style_(std::move(node.style_)),
+      // Shared rather than moved, so that the moved-from node keeps a style
+      style_(node.style_),
       layout_(node.layout_),
       lineIndex_(node.lineIndex_),
       contentsChildrenCount_(node.contentsChildrenCount_),
+      absoluteDescendantCount_(node.absoluteDescendantCount_),
       owner_(node.owner_),
       children_(std::move(node.children_)),
       config_(node.config_),
@@ -87,7 +99,7 @@ float Node::dimensionWithMargin(
     const FlexDirection axis,
     const float widthSize) {
   return getLayout().measuredDimension(dimension(axis)) +
-      style_.computeMarginForAxis(axis, widthSize);
+      style_->computeMarginForAxis(axis, widthSize);
 }
 
 bool Node::isLayoutDimensionDefined(const FlexDirection axis) {
@@ -160,7 +172,7 @@ void Node::setConfig(yoga::Config* config) {
       "UseWebDefaults may not be changed after constructing a Node");
 
   if (yoga::configUpdateInvalidatesLayout(*config_, *config)) {
-    markDirtyAndPropagate();
+    markDirtyAndPropagate(DirtyReason::kConfigChange);
     layout_.configVersion = 0;
   } else {
     // If the config is functionally the same, then align the configVersion so
@@ -235,6 +247,11 @@ void Node::setLayoutComputedFlexBasisGeneration(
   layout_.computedFlexBasisGeneration = computedFlexBasisGeneration;
 }
 
+void Node::setLayoutCachedBaseline(
+    LayoutResults::CachedBaseline cachedBaseline) {
+  layout_.cachedBaseline = cachedBaseline;
+}
+
 void Node::setLayoutMeasuredDimension(
     float measuredDimension,
     Dimension dimension) {
@@ -256,15 +273,16 @@ float Node::relativePosition(
     FlexDirection axis,
     Direction direction,
     float axisSize) const {
-  if (style_.positionType() == PositionType::Static) {
+  if (style_->positionType() == PositionType::Static ||
+      !style_->hasPosition()) {
     return 0;
   }
-  if (style_.isInlineStartPositionDefined(axis, direction) &&
-      !style_.isInlineStartPositionAuto(axis, direction)) {
-    return style_.computeInlineStartPosition(axis, direction, axisSize);
+  if (style_->isInlineStartPositionDefined(axis, direction) &&
+      !style_->isInlineStartPositionAuto(axis, direction)) {
+    return style_->computeInlineStartPosition(axis, direction, axisSize);
   }
 
-  return -1 * style_.computeInlineEndPosition(axis, direction, axisSize);
+  return -1 * style_->computeInlineEndPosition(axis, direction, axisSize);
 }
 
 void Node::setPosition(
@@ -276,7 +294,7 @@ void Node::setPosition(
   const Direction directionRespectingRoot =
       owner_ != nullptr ? direction : Direction::LTR;
   const FlexDirection mainAxis =
-      yoga::resolveDirection(style_.flexDirection(), directionRespectingRoot);
+      yoga::resolveDirection(style_->flexDirection(), directionRespectingRoot);
   const FlexDirection crossAxis =
       yoga::resolveCrossDirection(mainAxis, directionRespectingRoot);
 
@@ -297,29 +315,29 @@ void Node::setPosition(
   const auto crossAxisTrailingEdge = inlineEndEdge(crossAxis, direction);
 
   setLayoutPosition(
-      (style_.computeInlineStartMargin(mainAxis, direction, ownerWidth) +
+      (style_->computeInlineStartMargin(mainAxis, direction, ownerWidth) +
        relativePositionMain),
       mainAxisLeadingEdge);
   setLayoutPosition(
-      (style_.computeInlineEndMargin(mainAxis, direction, ownerWidth) +
+      (style_->computeInlineEndMargin(mainAxis, direction, ownerWidth) +
        relativePositionMain),
       mainAxisTrailingEdge);
   setLayoutPosition(
-      (style_.computeInlineStartMargin(crossAxis, direction, ownerWidth) +
+      (style_->computeInlineStartMargin(crossAxis, direction, ownerWidth) +
        relativePositionCross),
       crossAxisLeadingEdge);
   setLayoutPosition(
-      (style_.computeInlineEndMargin(crossAxis, direction, ownerWidth) +
+      (style_->computeInlineEndMargin(crossAxis, direction, ownerWidth) +
        relativePositionCross),
       crossAxisTrailingEdge);
 }
 
 Style::SizeLength Node::processFlexBasis() const {
-  Style::SizeLength flexBasis = style_.flexBasis();
+  Style::SizeLength flexBasis = style_->flexBasis();
   if (!flexBasis.isAuto() && !flexBasis.isUndefined()) {
     return flexBasis;
   }
-  if (style_.flex().isDefined() && style_.flex().unwrap() > 0.0f) {
+  if (style_->flex().isDefined() && style_->flex().unwrap() > 0.0f) {
     return config_->useWebDefaults() ? StyleSizeLength::ofAuto()
                                      : StyleSizeLength::points(0);
   }
@@ -332,13 +350,13 @@ FloatOptional Node::resolveFlexBasis(
     float referenceLength,
     float ownerWidth) const {
   FloatOptional value = processFlexBasis().resolve(referenceLength);
-  if (style_.boxSizing() == BoxSizing::BorderBox) {
+  if (style_->boxSizing() == BoxSizing::BorderBox) {
     return value;
   }
 
   Dimension dim = dimension(flexDirection);
   FloatOptional dimensionPaddingAndBorder = FloatOptional{
-      style_.computePaddingAndBorderForDimension(direction, dim, ownerWidth)};
+      style_->computePaddingAndBorderForDimension(direction, dim, ownerWidth)};
 
   return value +
       (dimensionPaddingAndBorder.isDefined() ? dimensionPaddingAndBorder
@@ -347,22 +365,23 @@ FloatOptional Node::resolveFlexBasis(
 
 void Node::processDimensions() {
   for (auto dim : {Dimension::Width, Dimension::Height}) {
-    if (style_.maxDimension(dim).isDefined() &&
+    if (style_->hasMaxDimension() && style_->maxDimension(dim).isDefined() &&
         yoga::inexactEquals(
-            style_.maxDimension(dim), style_.minDimension(dim))) {
-      processedDimensions_[yoga::to_underlying(dim)] = style_.maxDimension(dim);
+            style_->maxDimension(dim), style_->minDimension(dim))) {
+      processedDimensions_[yoga::to_underlying(dim)] =
+          style_->maxDimension(dim);
     } else {
-      processedDimensions_[yoga::to_underlying(dim)] = style_.dimension(dim);
+      processedDimensions_[yoga::to_underlying(dim)] = style_->dimension(dim);
     }
   }
 }
 
 Direction Node::resolveDirection(const Direction ownerDirection) {
-  if (style_.direction() == Direction::Inherit) {
+  if (style_->direction() == Direction::Inherit) {
     return ownerDirection != Direction::Inherit ? ownerDirection
                                                 : Direction::LTR;
   } else {
-    return style_.direction();
+    return style_->direction();
   }
 }
 
@@ -377,6 +396,8 @@ void Node::cloneChildrenIfNeeded() {
   size_t i = 0;
   for (Node*& child : children_) {
     if (child->getOwner() != this) {
+      // Counted as the size of a node, whatever the clone callback allocates
+      countAllocation(sizeof(Node));
       child = resolveRef(config_->cloneNode(child, this, i));
       child->setOwner(this);
     }
@@ -384,14 +405,25 @@ void Node::cloneChildrenIfNeeded() {
   }
 }
 
-void Node::markDirtyAndPropagate() {
-  if (!isDirty_) {
-    setDirty(true);
-    setLayoutComputedFlexBasis(FloatOptional());
-    if (owner_ != nullptr) {
-      owner_->markDirtyAndPropagate();
-    }
+void Node::markDirtyAndPropagate(DirtyReason reason) {
+  if (isDirty_) {
+    return;
   }
+
+  Node* topmostDirtied = this;
+  uint32_t ancestorsDirtied = 0;
+  setDirty(true);
+  setLayoutComputedFlexBasis(FloatOptional());
+  for (Node* ancestor = owner_; ancestor != nullptr && !ancestor->isDirty_;
+       ancestor = ancestor->owner_) {
+    ancestor->setDirty(true);
+    ancestor->setLayoutComputedFlexBasis(FloatOptional());
+    topmostDirtied = ancestor;
+    ancestorsDirtied++;
+  }
+
+  Event::publish<Event::NodeDirtied>(
+      this, {reason, ancestorsDirtied, topmostDirtied});
 }
 
 float Node::resolveFlexGrow() const {
@@ -399,11 +431,11 @@ float Node::resolveFlexGrow() const {
   if (owner_ == nullptr) {
     return 0.0;
   }
-  if (style_.flexGrow().isDefined()) {
-    return style_.flexGrow().unwrap();
+  if (style_->flexGrow().isDefined()) {
+    return style_->flexGrow().unwrap();
   }
-  if (style_.flex().isDefined() && style_.flex().unwrap() > 0.0f) {
-    return style_.flex().unwrap();
+  if (style_->flex().isDefined() && style_->flex().unwrap() > 0.0f) {
+    return style_->flex().unwrap();
   }
   return Style::DefaultFlexGrow;
 }
@@ -412,12 +444,12 @@ float Node::resolveFlexShrink() const {
   if (owner_ == nullptr) {
     return 0.0;
   }
-  if (style_.flexShrink().isDefined()) {
-    return style_.flexShrink().unwrap();
+  if (style_->flexShrink().isDefined()) {
+    return style_->flexShrink().unwrap();
   }
-  if (!config_->useWebDefaults() && style_.flex().isDefined() &&
-      style_.flex().unwrap() < 0.0f) {
-    return -style_.flex().unwrap();
+  if (!config_->useWebDefaults() && style_->flex().isDefined() &&
+      style_->flex().unwrap() < 0.0f) {
+    return -style_->flex().unwrap();
   }
   return config_->useWebDefaults() ? Style::WebDefaultFlexShrink
                                    : Style::DefaultFlexShrink;
@@ -425,7 +457,7 @@ float Node::resolveFlexShrink() const {
 
 bool Node::isNodeFlexible() {
   return (
-      (style_.positionType() != PositionType::Absolute) &&
+      (style_->positionType() != PositionType::Absolute) &&
       (resolveFlexGrow() != 0 || resolveFlexShrink() != 0));
 }
 
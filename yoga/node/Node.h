@@ -9,6 +9,7 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <memory>
 #include <vector>
 
 #include <yoga/Yoga.h>
@@ -22,6 +23,7 @@
 #include <yoga/enums/MeasureMode.h>
 #include <yoga/enums/NodeType.h>
 #include <yoga/enums/PhysicalEdge.h>
+#include <yoga/event/event.h>
 #include <yoga/node/LayoutResults.h>
 #include <yoga/style/Style.h>
 
@@ -101,12 +103,25 @@ class YG_EXPORT Node : public ::YGNode {
   }
 
   // For Performance reasons passing as reference.
-  Style& style() {
-    return style_;
+  const Style& style() const {
+    return *style_;
+  }
+
+  // Nodes with identical styles may share a single Style object, which is
+  // treated as immutable while shared. Any change to the style of a node must
+  // go through here, which gives the node its own copy first if needed.
+  // Sharing is judged from the use count of the style, which is only exact
+  // while no other thread copies or clones a node sharing it: nodes sharing a
+  // style must not be cloned on another thread while one of them is mutated.
+  Style& mutableStyle() {
+    if (style_.use_count() > 1) {
+      style_ = std::make_shared<Style>(*style_);
+    }
+    return *style_;
   }
 
-  const Style& style() const {
-    return style_;
+  bool sharesStyleWith(const Node& node) const {
+    return style_ == node.style_;
   }
 
   // For Performance reasons passing as reference.
@@ -122,6 +137,14 @@ class YG_EXPORT Node : public ::YGNode {
     return lineIndex_;
   }
 
+  // The number of absolutely positioned nodes in this subtree which are
+  // positioned relative to the containing block of this node's children, as
+  // of the last time this node was laid out. Lets a containing block skip the
+  // parts of its subtree which have no absolute descendants for it to lay out.
+  size_t getAbsoluteDescendantCount() const {
+    return absoluteDescendantCount_;
+  }
+
   bool isReferenceBaseline() const {
     return isReferenceBaseline_;
   }
@@ -183,12 +206,12 @@ class YG_EXPORT Node : public ::YGNode {
       float ownerWidth) const {
     FloatOptional value =
         getProcessedDimension(dimension).resolve(referenceLength);
-    if (style_.boxSizing() == BoxSizing::BorderBox) {
+    if (style_->boxSizing() == BoxSizing::BorderBox) {
       return value;
     }
 
     FloatOptional dimensionPaddingAndBorder =
-        FloatOptional{style_.computePaddingAndBorderForDimension(
+        FloatOptional{style_->computePaddingAndBorderForDimension(
             direction, dimension, ownerWidth)};
 
     return value +
@@ -225,9 +248,26 @@ class YG_EXPORT Node : public ::YGNode {
   }
 
   void setStyle(const Style& style) {
-    style_ = style;
+    style_ = std::make_shared<Style>(style);
+  }
+
+  // Makes this node share the style of another node, until one of them
+  // changes it.
+  void shareStyle(const Node& node) {
+    style_ = node.style_;
+  }
+
+  void shareStyle(std::shared_ptr<Style> style) {
+    style_ = std::move(style);
+  }
+
+  bool sharesStyle(const std::shared_ptr<Style>& style) const {
+    return style_ == style;
   }
 
+  // The style which nodes created with the config start out sharing
+  static const std::shared_ptr<Style>& defaultStyle(const Config& config);
+
   void setLayout(const LayoutResults& layout) {
     layout_ = layout;
   }
@@ -236,6 +276,10 @@ class YG_EXPORT Node : public ::YGNode {
     lineIndex_ = lineIndex;
   }
 
+  void setAbsoluteDescendantCount(size_t absoluteDescendantCount) {
+    absoluteDescendantCount_ = absoluteDescendantCount;
+  }
+
   void setIsReferenceBaseline(bool isReferenceBaseline) {
     isReferenceBaseline_ = isReferenceBaseline;
   }
@@ -257,6 +301,7 @@ class YG_EXPORT Node : public ::YGNode {
   void setLayoutComputedFlexBasis(FloatOptional computedFlexBasis);
   void setLayoutComputedFlexBasisGeneration(
       uint32_t computedFlexBasisGeneration);
+  void setLayoutCachedBaseline(LayoutResults::CachedBaseline cachedBaseline);
   void setLayoutMeasuredDimension(float measuredDimension, Dimension dimension);
   void setLayoutHadOverflow(bool hadOverflow);
   void setLayoutDimension(float lengthValue, Dimension dimension);
@@ -286,7 +331,9 @@ class YG_EXPORT Node : public ::YGNode {
   void removeChild(size_t index);
 
   void cloneChildrenIfNeeded();
-  void markDirtyAndPropagate();
+  // Marks the node and its ancestors dirty, up to the first which already
+  // is, and publishes a NodeDirtied event for the node
+  void markDirtyAndPropagate(DirtyReason reason);
   float resolveFlexGrow() const;
   float resolveFlexShrink() const;
   bool isNodeFlexible();
@@ -301,11 +348,6 @@ class YG_EXPORT Node : public ::YGNode {
       Direction direction,
       float axisSize) const;
 
-  void useWebDefaults() {
-    style_.setFlexDirection(FlexDirection::Row);
-    style_.setAlignContent(Align::Stretch);
-  }
-
   bool hasNewLayout_ : 1 = true;
   bool isReferenceBaseline_ : 1 = false;
   bool isDirty_ : 1 = true;
@@ -315,10 +357,11 @@ class YG_EXPORT Node : public ::YGNode {
   YGMeasureFunc measureFunc_ = nullptr;
   YGBaselineFunc baselineFunc_ = nullptr;
   YGDirtiedFunc dirtiedFunc_ = nullptr;
-  Style style_;
+  std::shared_ptr<Style> style_;
   LayoutResults layout_;
   size_t lineIndex_ = 0;
   size_t contentsChildrenCount_ = 0;
+  size_t absoluteDescendantCount_ = 0;
   Node* owner_ = nullptr;
   std::vector<Node*> children_;
   const Config* config_;
@@ -14,11 +14,16 @@
 #include <memory>
 #include <vector>
 
+#include <yoga/debug/AllocationCounter.h>
+
 namespace facebook::yoga {
 
 // Container which allows storing 32 or 64 bit integer values, whose index may
 // never change. Values are first stored in a fixed buffer of `BufferSize`
-// 32-bit chunks, before falling back to heap allocation.
+// 32-bit chunks, before falling back to heap allocation. Chunks of values which
+// are freed are reused by later 32-bit values, and freed chunks at the end of
+// the buffer are given back, so that repeatedly replacing values does not grow
+// the buffer without bound.
 template <size_t BufferSize>
 class SmallValueBuffer {
  public:
@@ -30,68 +35,63 @@ class SmallValueBuffer {
 
   // Add a new element to the buffer, returning the index of the element
   uint16_t push(uint32_t value) {
-    const auto index = count_++;
-    assert(index < 4096 && "SmallValueBuffer can only hold up to 4096 chunks");
-    if (index < buffer_.size()) {
-      buffer_[index] = value;
+    if (freeHead_ != kNoFreeChunk) {
+      // Free chunks store the index of the next free chunk
+      const auto index = freeHead_;
+      freeHead_ = static_cast<uint16_t>(get32(index));
+      freeCount_--;
+      set32(index, value);
       return index;
     }
 
-    if (overflow_ == nullptr) {
-      overflow_ = std::make_unique<SmallValueBuffer::Overflow>();
-    }
-
-    overflow_->buffer_.push_back(value);
-    overflow_->wideElements_.push_back(false);
-    return index;
+    return append(value);
   }
 
   uint16_t push(uint64_t value) {
     const auto lsb = static_cast<uint32_t>(value & 0xFFFFFFFF);
     const auto msb = static_cast<uint32_t>(value >> 32);
 
-    const auto lsbIndex = push(lsb);
-    [[maybe_unused]] const auto msbIndex = push(msb);
+    // Wide elements need two adjacent chunks, so do not use the free list
+    const auto lsbIndex = append(lsb);
+    [[maybe_unused]] const auto msbIndex = append(msb);
     assert(
         msbIndex < 4096 && "SmallValueBuffer can only hold up to 4096 chunks");
 
-    if (lsbIndex < buffer_.size()) {
-      wideElements_[lsbIndex] = true;
-    } else {
-      overflow_->wideElements_[lsbIndex - buffer_.size()] = true;
-    }
+    setWide(lsbIndex, true);
     return lsbIndex;
   }
 
   // Replace an existing element in the buffer with a new value. A new index
   // may be returned, e.g. if a new value is wider than the previous.
   [[nodiscard]] uint16_t replace(uint16_t index, uint32_t value) {
-    if (index < buffer_.size()) {
-      buffer_[index] = value;
-    } else {
-      overflow_->buffer_.at(index - buffer_.size()) = value;
-    }
-
+    set32(index, value);
     return index;
   }
 
   [[nodiscard]] uint16_t replace(uint16_t index, uint64_t value) {
-    const bool isWide = index < wideElements_.size()
-        ? wideElements_[index]
-        : overflow_->wideElements_.at(index - buffer_.size());
-
-    if (isWide) {
+    if (isWide(index)) {
       const auto lsb = static_cast<uint32_t>(value & 0xFFFFFFFF);
       const auto msb = static_cast<uint32_t>(value >> 32);
 
-      [[maybe_unused]] auto lsbIndex = replace(index, lsb);
-      [[maybe_unused]] auto msbIndex = replace(index + 1, msb);
+      set32(index, lsb);
+      set32(index + 1, msb);
       return index;
     } else {
+      free(index);
       return push(value);
     }
   }
 
+  // Remove an element from the buffer. Its index may be returned by a later
+  // push.
+  void free(uint16_t index) {
+    if (isWide(index)) {
+      setWide(index, false);
+      release(index + 1);
+    }
+    release(index);
+  }
+
   // Get a value of a given width
   uint32_t get32(uint16_t index) const {
     if (index < buffer_.size()) {
@@ -107,24 +107,105 @@ class SmallValueBuffer {
     return (static_cast<uint64_t>(msb) << 32) | lsb;
   }
 
+  // The number of chunks spanned by the elements of the buffer, including free
+  // chunks which have not been reused yet
+  size_t size() const {
+    return count_;
+  }
+
   SmallValueBuffer& operator=(const SmallValueBuffer& other) {
     count_ = other.count_;
+    freeHead_ = other.freeHead_;
+    freeCount_ = other.freeCount_;
     buffer_ = other.buffer_;
     wideElements_ = other.wideElements_;
-    overflow_ = other.overflow_ ? std::make_unique<Overflow>(*other.overflow_)
-                                : nullptr;
+    if (other.overflow_ != nullptr) {
+      countAllocation(sizeof(Overflow));
+      overflow_ = std::make_unique<Overflow>(*other.overflow_);
+    } else {
+      overflow_ = nullptr;
+    }
     return *this;
   }
 
   SmallValueBuffer& operator=(SmallValueBuffer&& other) noexcept = default;
 
  private:
+  static constexpr uint16_t kNoFreeChunk = 0xFFFF;
+
+  uint16_t append(uint32_t value) {
+    const auto index = count_++;
+    assert(index < 4096 && "SmallValueBuffer can only hold up to 4096 chunks");
+    if (index < buffer_.size()) {
+      buffer_[index] = value;
+      return index;
+    }
+
+    if (overflow_ == nullptr) {
+      countAllocation(sizeof(SmallValueBuffer::Overflow));
+      overflow_ = std::make_unique<SmallValueBuffer::Overflow>();
+    }
+
+    overflow_->buffer_.push_back(value);
+    overflow_->wideElements_.push_back(false);
+    return index;
+  }
+
+  void release(uint16_t index) {
+    if (index + 1 == count_) {
+      count_--;
+      if (index >= buffer_.size()) {
+        overflow_->buffer_.pop_back();
+        overflow_->wideElements_.pop_back();
+      }
+    } else {
+      set32(index, freeHead_);
+      freeHead_ = index;
+      freeCount_++;
+    }
+
+    if (freeCount_ == count_) {
+      // Every remaining chunk is free, so start over from an empty buffer
+      count_ = 0;
+      freeCount_ = 0;
+      freeHead_ = kNoFreeChunk;
+      if (overflow_ != nullptr) {
+        overflow_->buffer_.clear();
+        overflow_->wideElements_.clear();
+      }
+    }
+  }
+
+  void set32(uint16_t index, uint32_t value) {
+    if (index < buffer_.size()) {
+      buffer_[index] = value;
+    } else {
+      overflow_->buffer_.at(index - buffer_.size()) = value;
+    }
+  }
+
+  bool isWide(uint16_t index) const {
+    return index < wideElements_.size()
+        ? wideElements_[index]
+        : overflow_->wideElements_.at(index - buffer_.size());
+  }
+
+  void setWide(uint16_t index, bool isWide) {
+    if (index < wideElements_.size()) {
+      wideElements_[index] = isWide;
+    } else {
+      overflow_->wideElements_.at(index - buffer_.size()) = isWide;
+    }
+  }
+
   struct Overflow {
-    std::vector<uint32_t> buffer_;
-    std::vector<bool> wideElements_;
+    std::vector<uint32_t, CountingAllocator<uint32_t>> buffer_;
+    std::vector<bool, CountingAllocator<bool>> wideElements_;
   };
 
   uint16_t count_{0};
+  uint16_t freeHead_{kNoFreeChunk};
+  uint16_t freeCount_{0};
   std::array<uint32_t, BufferSize> buffer_{};
   std::bitset<BufferSize> wideElements_;
   std::unique_ptr<Overflow> overflow_;
@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+#include <yoga/style/Style.h>
+
+namespace facebook::yoga {
+
+// Version 1 of the encoding holds, in little-endian byte order:
+//  - the version, in one byte
+//  - the enum properties, packed into 32 bits in member order
+//  - a 64-bit mask of the value handles which differ from their default
+//  - each of those handles, packed into 16 bits the way StyleValueHandle
+//    stores them, except that values which do not fit inline refer to their
+//    position in the list which follows
+//  - the 32-bit values which did not fit inline
+static constexpr uint8_t kEncodingVersion = 1;
+static constexpr size_t kHeaderSize = 1 + sizeof(uint32_t) + sizeof(uint64_t);
+
+// Enum properties are packed using as many bits as their bitfields, so adding
+// enough values to an enum to widen its bitfield changes the encoding, and
+// needs a new version.
+static_assert(
+    kEncodingVersion == 1 && bitCount<Direction>() == 2 &&
+        bitCount<FlexDirection>() == 2 && bitCount<Justify>() == 3 &&
+        bitCount<Align>() == 4 && bitCount<PositionType>() == 2 &&
+        bitCount<Wrap>() == 2 && bitCount<Overflow>() == 2 &&
+        bitCount<Display>() == 2 && bitCount<BoxSizing>() == 1,
+    "Enum properties changed width, bump kEncodingVersion");
+
+template <typename T>
+static void writeLittleEndian(uint8_t* data, T value) {
+  for (size_t i = 0; i < sizeof(T); i++) {
+    data[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+template <typename T>
+static T readLittleEndian(const uint8_t* data) {
+  T value = 0;
+  for (size_t i = 0; i < sizeof(T); i++) {
+    value |= static_cast<T>(data[i]) << (8 * i);
+  }
+  return value;
+}
+
+namespace {
+
+// Packs enum properties next to each other, using as few bits as their
+// bitfields in Style
+class EnumBits {
+ public:
+  explicit EnumBits(uint32_t bits = 0) : bits_{bits} {}
+
+  template <typename EnumT>
+  void pack(EnumT value) {
+    bits_ |= static_cast<uint32_t>(yoga::to_underlying(value)) << offset_;
+    offset_ += bitCount<EnumT>();
+  }
+
+  template <typename EnumT>
+  bool unpack(Style& style, void (Style::*setter)(EnumT)) {
+    const uint32_t value =
+        (bits_ >> offset_) & ((uint32_t{1} << bitCount<EnumT>()) - 1);
+    offset_ += bitCount<EnumT>();
+    if (value >= static_cast<uint32_t>(ordinalCount<EnumT>())) {
+      return false;
+    }
+    (style.*setter)(static_cast<EnumT>(value));
+    return true;
+  }
+
+  uint32_t bits() const {
+    assert(offset_ <= 32 && "Enum properties do not fit in 32 bits");
+    return bits_;
+  }
+
+ private:
+  uint32_t bits_;
+  int32_t offset_ = 0;
+};
+
+} // namespace
+
+size_t Style::serialize(uint8_t* buffer, size_t capacity) const {
+  static const Style defaults{};
+  const auto handles = valueHandles();
+  const auto defaultHandles = defaults.valueHandles();
+
+  uint64_t mask = 0;
+  std::array<uint16_t, kValueHandleCount> packed{};
+  size_t handleCount = 0;
+  std::array<uint32_t, kValueHandleCount> values{};
+  size_t valueCount = 0;
+  for (size_t i = 0; i < kValueHandleCount; i++) {
+    if (*handles[i] != *defaultHandles[i]) {
+      mask |= uint64_t{1} << i;
+      packed[handleCount++] =
+          pool_.exportHandle(*handles[i], values.data(), valueCount);
+    }
+  }
+
+  const size_t size = kHeaderSize + handleCount * sizeof(uint16_t) +
+      valueCount * sizeof(uint32_t);
+  if (buffer == nullptr || capacity < size) {
+    return size;
+  }
+
+  EnumBits enums;
+  enums.pack(direction_);
+  enums.pack(flexDirection_);
+  enums.pack(justifyContent_);
+  enums.pack(alignContent_);
+  enums.pack(alignItems_);
+  enums.pack(alignSelf_);
+  enums.pack(positionType_);
+  enums.pack(flexWrap_);
+  enums.pack(overflow_);
+  enums.pack(display_);
+  enums.pack(boxSizing_);
+
+  uint8_t* data = buffer;
+  *data++ = kEncodingVersion;
+  writeLittleEndian(data, enums.bits());
+  data += sizeof(uint32_t);
+  writeLittleEndian(data, mask);
+  data += sizeof(uint64_t);
+  for (size_t i = 0; i < handleCount; i++, data += sizeof(uint16_t)) {
+    writeLittleEndian(data, packed[i]);
+  }
+  for (size_t i = 0; i < valueCount; i++, data += sizeof(uint32_t)) {
+    writeLittleEndian(data, values[i]);
+  }
+  return size;
+}
+
+std::optional<Style> Style::deserialize(const uint8_t* data, size_t size) {
+  if (data == nullptr || size < kHeaderSize || data[0] != kEncodingVersion) {
+    return std::nullopt;
+  }
+
+  Style style;
+  EnumBits enums{readLittleEndian<uint32_t>(data + 1)};
+  const bool enumsValid = enums.unpack(style, &Style::setDirection) &&
+      enums.unpack(style, &Style::setFlexDirection) &&
+      enums.unpack(style, &Style::setJustifyContent) &&
+      enums.unpack(style, &Style::setAlignContent) &&
+      enums.unpack(style, &Style::setAlignItems) &&
+      enums.unpack(style, &Style::setAlignSelf) &&
+      enums.unpack(style, &Style::setPositionType) &&
+      enums.unpack(style, &Style::setFlexWrap) &&
+      enums.unpack(style, &Style::setOverflow) &&
+      enums.unpack(style, &Style::setDisplay) &&
+      enums.unpack(style, &Style::setBoxSizing);
+  if (!enumsValid) {
+    return std::nullopt;
+  }
+
+  const auto mask = readLittleEndian<uint64_t>(data + 1 + sizeof(uint32_t));
+  if ((mask >> kValueHandleCount) != 0) {
+    return std::nullopt;
+  }
+
+  // Whatever follows the handles is the list of values they refer to
+  const size_t handleCount = static_cast<size_t>(std::popcount(mask));
+  const size_t handlesEnd = kHeaderSize + handleCount * sizeof(uint16_t);
+  if (size < handlesEnd || (size - handlesEnd) % sizeof(uint32_t) != 0) {
+    return std::nullopt;
+  }
+  const size_t valueCount = (size - handlesEnd) / sizeof(uint32_t);
+  if (valueCount > handleCount) {
+    return std::nullopt;
+  }
+  std::array<uint32_t, kValueHandleCount> values{};
+  for (size_t i = 0; i < valueCount; i++) {
+    values[i] =
+        readLittleEndian<uint32_t>(data + handlesEnd + i * sizeof(uint32_t));
+  }
+
+  const uint8_t* handles = data + kHeaderSize;
+  for (size_t i = 0; i < kValueHandleCount; i++) {
+    if ((mask & (uint64_t{1} << i)) == 0) {
+      continue;
+    }
+    const auto packed = readLittleEndian<uint16_t>(handles);
+    handles += sizeof(uint16_t);
+    if (!style.importValueHandle(
+            i, packed, std::span{values.data(), valueCount})) {
+      return std::nullopt;
+    }
+  }
+  style.restoreDerivedState();
+  return style;
+}
+
+std::array<const StyleValueHandle*, Style::kValueHandleCount>
+Style::valueHandles() const {
+  static_assert(
+      kValueHandleCount ==
+      4 + 4 * ordinalCount<Edge>() + ordinalCount<Gutter>() +
+          3 * ordinalCount<Dimension>() + 1);
+  static_assert(kValueHandleCount <= 64, "Handles must fit in the mask");
+  static_assert(
+      kEncodingVersion == 1 && kValueHandleCount == 50,
+      "Value handles changed, bump kEncodingVersion");
+
+  std::array<const StyleValueHandle*, kValueHandleCount> handles{};
+  size_t count = 0;
+  const auto addAll = [&](const auto& group) {
+    for (const auto& handle : group) {
+      handles[count++] = &handle;
+    }
+  };
+
+  handles[count++] = &flex_;
+  handles[count++] = &flexGrow_;
+  handles[count++] = &flexShrink_;
+  handles[count++] = &flexBasis_;
+  addAll(margin_);
+  addAll(position_);
+  addAll(padding_);
+  addAll(border_);
+  addAll(gap_);
+  addAll(dimensions_);
+  addAll(minDimensions_);
+  addAll(maxDimensions_);
+  handles[count++] = &aspectRatio_;
+  assert(count == kValueHandleCount);
+  return handles;
+}
+
+bool Style::importValueHandle(
+    size_t index,
+    uint16_t packed,
+    std::span<const uint32_t> values) {
+  const auto number = StyleValuePool::importNumber(packed, values);
+  const auto length = StyleValuePool::importLength(packed, values);
+  const auto size = StyleValuePool::importSize(packed, values);
+
+  // Each property only accepts the units its public setters produce
+  const auto restoreNumber = [&](StyleValueHandle& handle) {
+    if (!number.has_value()) {
+      return false;
+    }
+    pool_.store(handle, *number);
+    return true;
+  };
+  const auto restoreLength =
+      [&](StyleValueHandle& handle, bool allowPercent, bool allowAuto) {
+        if (!length.has_value() || (!allowPercent && length->isPercent()) ||
+            (!allowAuto && length->isAuto())) {
+          return false;
+        }
+        pool_.store(handle, *length);
+        return true;
+      };
+  const auto restoreSize = [&](StyleValueHandle& handle, bool allowAuto) {
+    if (!size.has_value() || (!allowAuto && size->isAuto())) {
+      return false;
+    }
+    pool_.store(handle, *size);
+    return true;
+  };
+
+  switch (index) {
+    case 0:
+      return restoreNumber(flex_);
+    case 1:
+      return restoreNumber(flexGrow_);
+    case 2:
+      return restoreNumber(flexShrink_);
+    case 3:
+      return restoreSize(flexBasis_, /*allowAuto*/ true);
+    case kValueHandleCount - 1:
+      // The setter stores degenerate aspect ratios as undefined
+      if (number.has_value() &&
+          (*number == 0.0f || std::isinf(number->unwrap()))) {
+        return false;
+      }
+      return restoreNumber(aspectRatio_);
+    default:
+      break;
+  }
+
+  index -= 4;
+  constexpr auto edges = static_cast<size_t>(ordinalCount<Edge>());
+  const auto edge = index % edges;
+  switch (index / edges) {
+    case 0:
+      return restoreLength(
+          margin_[edge], /*allowPercent*/ true, /*allowAuto*/ true);
+    case 1:
+      return restoreLength(
+          position_[edge], /*allowPercent*/ true, /*allowAuto*/ true);
+    case 2:
+      return restoreLength(
+          padding_[edge], /*allowPercent*/ true, /*allowAuto*/ false);
+    case 3:
+      return restoreLength(
+          border_[edge], /*allowPercent*/ false, /*allowAuto*/ false);
+    default:
+      break;
+  }
+
+  index -= 4 * edges;
+  constexpr auto gutters = static_cast<size_t>(ordinalCount<Gutter>());
+  if (index < gutters) {
+    return restoreLength(
+        gap_[index], /*allowPercent*/ true, /*allowAuto*/ false);
+  }
+
+  index -= gutters;
+  constexpr auto dimensions = static_cast<size_t>(ordinalCount<Dimension>());
+  const auto axis = index % dimensions;
+  switch (index / dimensions) {
+    case 0:
+      return restoreSize(dimensions_[axis], /*allowAuto*/ true);
+    case 1:
+      return restoreSize(minDimensions_[axis], /*allowAuto*/ false);
+    default:
+      return restoreSize(maxDimensions_[axis], /*allowAuto*/ false);
+  }
+}
+
+void Style::restoreDerivedState() {
+  resolveEdges(margin_, resolvedMargin_);
+  resolveEdges(position_, resolvedPosition_);
+  resolveEdges(padding_, resolvedPadding_);
+  resolveEdges(border_, resolvedBorder_);
+
+  updateFeature(Feature::Margin, anyDefined(margin_));
+  updateFeature(Feature::Position, anyDefined(position_));
+  updateFeature(Feature::Padding, anyDefined(padding_));
+  updateFeature(Feature::Border, anyDefined(border_));
+  updateFeature(Feature::Gap, anyDefined(gap_));
+  updateFeature(Feature::MinDimension, anyDefined(minDimensions_));
+  updateFeature(Feature::MaxDimension, anyDefined(maxDimensions_));
+  updateFeature(Feature::AspectRatio, aspectRatio_.isDefined());
+
+  // The value handles held their defaults before they were restored, so each
+  // contributes the change from its default
+  static const Style defaults{};
+  updateFingerprint(StyleProperty::Flex, defaults.flex(), flex());
+  updateFingerprint(StyleProperty::FlexGrow, defaults.flexGrow(), flexGrow());
+  updateFingerprint(
+      StyleProperty::FlexShrink, defaults.flexShrink(), flexShrink());
+  updateFingerprint(
+      StyleProperty::FlexBasis, defaults.flexBasis(), flexBasis());
+  updateFingerprint(
+      StyleProperty::AspectRatio, defaults.aspectRatio(), aspectRatio());
+  for (const auto edge : ordinals<Edge>()) {
+    updateFingerprint(
+        StyleProperty::Margin, edge, defaults.margin(edge), margin(edge));
+    updateFingerprint(
+        StyleProperty::Position, edge, defaults.position(edge), position(edge));
+    updateFingerprint(
+        StyleProperty::Padding, edge, defaults.padding(edge), padding(edge));
+    updateFingerprint(
+        StyleProperty::Border, edge, defaults.border(edge), border(edge));
+  }
+  for (const auto gutter : ordinals<Gutter>()) {
+    updateFingerprint(
+        StyleProperty::Gap, gutter, defaults.gap(gutter), gap(gutter));
+  }
+  for (const auto axis : ordinals<Dimension>()) {
+    updateFingerprint(
+        StyleProperty::Width, axis, defaults.dimension(axis), dimension(axis));
+    updateFingerprint(
+        StyleProperty::MinWidth,
+        axis,
+        defaults.minDimension(axis),
+        minDimension(axis));
+    updateFingerprint(
+        StyleProperty::MaxWidth,
+        axis,
+        defaults.maxDimension(axis),
+        maxDimension(axis));
+  }
+}
+
+} // namespace facebook::yoga
@@ -8,7 +8,11 @@
 #pragma once
 
 #include <array>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <span>
 #include <type_traits>
 
 #include <yoga/Yoga.h>
@@ -26,6 +30,7 @@
 #include <yoga/enums/Overflow.h>
 #include <yoga/enums/PhysicalEdge.h>
 #include <yoga/enums/PositionType.h>
+#include <yoga/enums/StyleProperty.h>
 #include <yoga/enums/Unit.h>
 #include <yoga/enums/Wrap.h>
 #include <yoga/numeric/FloatOptional.h>
@@ -48,6 +53,7 @@ class YG_EXPORT Style {
     return direction_;
   }
   void setDirection(Direction value) {
+    updateFingerprint(StyleProperty::Direction, direction_, value);
     direction_ = value;
   }
 
@@ -55,6 +61,7 @@ class YG_EXPORT Style {
     return flexDirection_;
   }
   void setFlexDirection(FlexDirection value) {
+    updateFingerprint(StyleProperty::FlexDirection, flexDirection_, value);
     flexDirection_ = value;
   }
 
@@ -62,6 +69,7 @@ class YG_EXPORT Style {
     return justifyContent_;
   }
   void setJustifyContent(Justify value) {
+    updateFingerprint(StyleProperty::JustifyContent, justifyContent_, value);
     justifyContent_ = value;
   }
 
@@ -69,6 +77,7 @@ class YG_EXPORT Style {
     return alignContent_;
   }
   void setAlignContent(Align value) {
+    updateFingerprint(StyleProperty::AlignContent, alignContent_, value);
     alignContent_ = value;
   }
 
@@ -76,6 +85,7 @@ class YG_EXPORT Style {
     return alignItems_;
   }
   void setAlignItems(Align value) {
+    updateFingerprint(StyleProperty::AlignItems, alignItems_, value);
     alignItems_ = value;
   }
 
@@ -83,6 +93,7 @@ class YG_EXPORT Style {
     return alignSelf_;
   }
   void setAlignSelf(Align value) {
+    updateFingerprint(StyleProperty::AlignSelf, alignSelf_, value);
     alignSelf_ = value;
   }
 
@@ -90,6 +101,7 @@ class YG_EXPORT Style {
     return positionType_;
   }
   void setPositionType(PositionType value) {
+    updateFingerprint(StyleProperty::PositionType, positionType_, value);
     positionType_ = value;
   }
 
@@ -97,6 +109,7 @@ class YG_EXPORT Style {
     return flexWrap_;
   }
   void setFlexWrap(Wrap value) {
+    updateFingerprint(StyleProperty::FlexWrap, flexWrap_, value);
     flexWrap_ = value;
   }
 
@@ -104,6 +117,7 @@ class YG_EXPORT Style {
     return overflow_;
   }
   void setOverflow(Overflow value) {
+    updateFingerprint(StyleProperty::Overflow, overflow_, value);
     overflow_ = value;
   }
 
@@ -111,6 +125,7 @@ class YG_EXPORT Style {
     return display_;
   }
   void setDisplay(Display value) {
+    updateFingerprint(StyleProperty::Display, display_, value);
     display_ = value;
   }
 
@@ -118,6 +133,7 @@ class YG_EXPORT Style {
     return pool_.getNumber(flex_);
   }
   void setFlex(FloatOptional value) {
+    updateFingerprint(StyleProperty::Flex, flex(), value);
     pool_.store(flex_, value);
   }
 
@@ -125,6 +141,7 @@ class YG_EXPORT Style {
     return pool_.getNumber(flexGrow_);
   }
   void setFlexGrow(FloatOptional value) {
+    updateFingerprint(StyleProperty::FlexGrow, flexGrow(), value);
     pool_.store(flexGrow_, value);
   }
 
@@ -132,6 +149,7 @@ class YG_EXPORT Style {
     return pool_.getNumber(flexShrink_);
   }
   void setFlexShrink(FloatOptional value) {
+    updateFingerprint(StyleProperty::FlexShrink, flexShrink(), value);
     pool_.store(flexShrink_, value);
   }
 
@@ -139,6 +157,7 @@ class YG_EXPORT Style {
     return pool_.getSize(flexBasis_);
   }
   void setFlexBasis(Style::SizeLength value) {
+    updateFingerprint(StyleProperty::FlexBasis, flexBasis(), value);
     pool_.store(flexBasis_, value);
   }
 
@@ -146,41 +165,57 @@ class YG_EXPORT Style {
     return pool_.getLength(margin_[yoga::to_underlying(edge)]);
   }
   void setMargin(Edge edge, Style::Length value) {
+    updateFingerprint(StyleProperty::Margin, edge, margin(edge), value);
     pool_.store(margin_[yoga::to_underlying(edge)], value);
+    resolveEdges(margin_, resolvedMargin_);
+    updateFeature(Feature::Margin, value.isDefined() || anyDefined(margin_));
   }
 
   Style::Length position(Edge edge) const {
     return pool_.getLength(position_[yoga::to_underlying(edge)]);
   }
   void setPosition(Edge edge, Style::Length value) {
+    updateFingerprint(StyleProperty::Position, edge, position(edge), value);
     pool_.store(position_[yoga::to_underlying(edge)], value);
+    resolveEdges(position_, resolvedPosition_);
+    updateFeature(
+        Feature::Position, value.isDefined() || anyDefined(position_));
   }
 
   Style::Length padding(Edge edge) const {
     return pool_.getLength(padding_[yoga::to_underlying(edge)]);
   }
   void setPadding(Edge edge, Style::Length value) {
+    updateFingerprint(StyleProperty::Padding, edge, padding(edge), value);
     pool_.store(padding_[yoga::to_underlying(edge)], value);
+    resolveEdges(padding_, resolvedPadding_);
+    updateFeature(Feature::Padding, value.isDefined() || anyDefined(padding_));
   }
 
   Style::Length border(Edge edge) const {
     return pool_.getLength(border_[yoga::to_underlying(edge)]);
   }
   void setBorder(Edge edge, Style::Length value) {
+    updateFingerprint(StyleProperty::Border, edge, border(edge), value);
     pool_.store(border_[yoga::to_underlying(edge)], value);
+    resolveEdges(border_, resolvedBorder_);
+    updateFeature(Feature::Border, value.isDefined() || anyDefined(border_));
   }
 
   Style::Length gap(Gutter gutter) const {
     return pool_.getLength(gap_[yoga::to_underlying(gutter)]);
   }
   void setGap(Gutter gutter, Style::Length value) {
+    updateFingerprint(StyleProperty::Gap, gutter, gap(gutter), value);
     pool_.store(gap_[yoga::to_underlying(gutter)], value);
+    updateFeature(Feature::Gap, value.isDefined() || anyDefined(gap_));
   }
 
   Style::SizeLength dimension(Dimension axis) const {
     return pool_.getSize(dimensions_[yoga::to_underlying(axis)]);
   }
   void setDimension(Dimension axis, Style::SizeLength value) {
+    updateFingerprint(StyleProperty::Width, axis, dimension(axis), value);
     pool_.store(dimensions_[yoga::to_underlying(axis)], value);
   }
 
@@ -188,7 +223,11 @@ class YG_EXPORT Style {
     return pool_.getSize(minDimensions_[yoga::to_underlying(axis)]);
   }
   void setMinDimension(Dimension axis, Style::SizeLength value) {
+    updateFingerprint(
+        StyleProperty::MinWidth, axis, minDimension(axis), value);
     pool_.store(minDimensions_[yoga::to_underlying(axis)], value);
+    updateFeature(
+        Feature::MinDimension, value.isDefined() || anyDefined(minDimensions_));
   }
 
   FloatOptional resolvedMinDimension(
@@ -196,6 +235,9 @@ class YG_EXPORT Style {
       Dimension axis,
       float referenceLength,
       float ownerWidth) const {
+    if (!hasMinDimension()) {
+      return FloatOptional{};
+    }
     FloatOptional value = minDimension(axis).resolve(referenceLength);
     if (boxSizing() == BoxSizing::BorderBox) {
       return value;
@@ -213,7 +255,11 @@ class YG_EXPORT Style {
     return pool_.getSize(maxDimensions_[yoga::to_underlying(axis)]);
   }
   void setMaxDimension(Dimension axis, Style::SizeLength value) {
+    updateFingerprint(
+        StyleProperty::MaxWidth, axis, maxDimension(axis), value);
     pool_.store(maxDimensions_[yoga::to_underlying(axis)], value);
+    updateFeature(
+        Feature::MaxDimension, value.isDefined() || anyDefined(maxDimensions_));
   }
 
   FloatOptional resolvedMaxDimension(
@@ -221,6 +267,9 @@ class YG_EXPORT Style {
       Dimension axis,
       float referenceLength,
       float ownerWidth) const {
+    if (!hasMaxDimension()) {
+      return FloatOptional{};
+    }
     FloatOptional value = maxDimension(axis).resolve(referenceLength);
     if (boxSizing() == BoxSizing::BorderBox) {
       return value;
@@ -240,18 +289,50 @@ class YG_EXPORT Style {
   void setAspectRatio(FloatOptional value) {
     // degenerate aspect ratios act as auto.
     // see https://drafts.csswg.org/css-sizing-4/#valdef-aspect-ratio-ratio
-    pool_.store(
-        aspectRatio_,
-        value == 0.0f || std::isinf(value.unwrap()) ? FloatOptional{} : value);
+    const FloatOptional aspectRatio =
+        value == 0.0f || std::isinf(value.unwrap()) ? FloatOptional{} : value;
+    updateFingerprint(
+        StyleProperty::AspectRatio, this->aspectRatio(), aspectRatio);
+    pool_.store(aspectRatio_, aspectRatio);
+    updateFeature(Feature::AspectRatio, aspectRatio.isDefined());
   }
 
   BoxSizing boxSizing() const {
     return boxSizing_;
   }
   void setBoxSizing(BoxSizing value) {
+    updateFingerprint(StyleProperty::BoxSizing, boxSizing_, value);
     boxSizing_ = value;
   }
 
+  // Whether any edge, gutter or axis of a family of properties is set. Kept up
+  // to date by the setters, so layout can skip resolving a whole family
+  // without reading from the pool.
+  bool hasMargin() const {
+    return hasFeature(Feature::Margin);
+  }
+  bool hasPosition() const {
+    return hasFeature(Feature::Position);
+  }
+  bool hasPadding() const {
+    return hasFeature(Feature::Padding);
+  }
+  bool hasBorder() const {
+    return hasFeature(Feature::Border);
+  }
+  bool hasGap() const {
+    return hasFeature(Feature::Gap);
+  }
+  bool hasMinDimension() const {
+    return hasFeature(Feature::MinDimension);
+  }
+  bool hasMaxDimension() const {
+    return hasFeature(Feature::MaxDimension);
+  }
+  bool hasAspectRatio() const {
+    return hasFeature(Feature::AspectRatio);
+  }
+
   bool horizontalInsetsDefined() const {
     return position_[yoga::to_underlying(Edge::Left)].isDefined() ||
         position_[yoga::to_underlying(Edge::Right)].isDefined() ||
@@ -268,49 +349,68 @@ class YG_EXPORT Style {
         position_[yoga::to_underlying(Edge::Vertical)].isDefined();
   }
 
+  Style::Length inlineStartPosition(FlexDirection axis, Direction direction)
+      const {
+    return computePosition(inlineStartEdge(axis, direction), direction);
+  }
+
+  Style::Length inlineEndPosition(FlexDirection axis, Direction direction)
+      const {
+    return computePosition(inlineEndEdge(axis, direction), direction);
+  }
+
   bool isFlexStartPositionDefined(FlexDirection axis, Direction direction)
       const {
-    return computePosition(flexStartEdge(axis), direction).isDefined();
+    return hasPosition() &&
+        computePosition(flexStartEdge(axis), direction).isDefined();
   }
 
   bool isFlexStartPositionAuto(FlexDirection axis, Direction direction) const {
-    return computePosition(flexStartEdge(axis), direction).isAuto();
+    return hasPosition() &&
+        computePosition(flexStartEdge(axis), direction).isAuto();
   }
 
   bool isInlineStartPositionDefined(FlexDirection axis, Direction direction)
       const {
-    return computePosition(inlineStartEdge(axis, direction), direction)
-        .isDefined();
+    return hasPosition() &&
+        computePosition(inlineStartEdge(axis, direction), direction)
+            .isDefined();
   }
 
   bool isInlineStartPositionAuto(FlexDirection axis, Direction direction)
       const {
-    return computePosition(inlineStartEdge(axis, direction), direction)
-        .isAuto();
+    return hasPosition() &&
+        computePosition(inlineStartEdge(axis, direction), direction).isAuto();
   }
 
   bool isFlexEndPositionDefined(FlexDirection axis, Direction direction) const {
-    return computePosition(flexEndEdge(axis), direction).isDefined();
+    return hasPosition() &&
+        computePosition(flexEndEdge(axis), direction).isDefined();
   }
 
   bool isFlexEndPositionAuto(FlexDirection axis, Direction direction) const {
-    return computePosition(flexEndEdge(axis), direction).isAuto();
+    return hasPosition() &&
+        computePosition(flexEndEdge(axis), direction).isAuto();
   }
 
   bool isInlineEndPositionDefined(FlexDirection axis, Direction direction)
       const {
-    return computePosition(inlineEndEdge(axis, direction), direction)
-        .isDefined();
+    return hasPosition() &&
+        computePosition(inlineEndEdge(axis, direction), direction).isDefined();
   }
 
   bool isInlineEndPositionAuto(FlexDirection axis, Direction direction) const {
-    return computePosition(inlineEndEdge(axis, direction), direction).isAuto();
+    return hasPosition() &&
+        computePosition(inlineEndEdge(axis, direction), direction).isAuto();
   }
 
   float computeFlexStartPosition(
       FlexDirection axis,
       Direction direction,
       float axisSize) const {
+    if (!hasPosition()) {
+      return 0.0f;
+    }
     return computePosition(flexStartEdge(axis), direction)
         .resolve(axisSize)
         .unwrapOrDefault(0.0f);
@@ -320,6 +420,9 @@ class YG_EXPORT Style {
       FlexDirection axis,
       Direction direction,
       float axisSize) const {
+    if (!hasPosition()) {
+      return 0.0f;
+    }
     return computePosition(inlineStartEdge(axis, direction), direction)
         .resolve(axisSize)
         .unwrapOrDefault(0.0f);
@@ -329,6 +432,9 @@ class YG_EXPORT Style {
       FlexDirection axis,
       Direction direction,
       float axisSize) const {
+    if (!hasPosition()) {
+      return 0.0f;
+    }
     return computePosition(flexEndEdge(axis), direction)
         .resolve(axisSize)
         .unwrapOrDefault(0.0f);
@@ -338,6 +444,9 @@ class YG_EXPORT Style {
       FlexDirection axis,
       Direction direction,
       float axisSize) const {
+    if (!hasPosition()) {
+      return 0.0f;
+    }
     return computePosition(inlineEndEdge(axis, direction), direction)
         .resolve(axisSize)
         .unwrapOrDefault(0.0f);
@@ -347,6 +456,9 @@ class YG_EXPORT Style {
       FlexDirection axis,
       Direction direction,
       float widthSize) const {
+    if (!hasMargin()) {
+      return 0.0f;
+    }
     return computeMargin(flexStartEdge(axis), direction)
         .resolve(widthSize)
         .unwrapOrDefault(0.0f);
@@ -356,6 +468,9 @@ class YG_EXPORT Style {
       FlexDirection axis,
       Direction direction,
       float widthSize) const {
+    if (!hasMargin()) {
+      return 0.0f;
+    }
     return computeMargin(inlineStartEdge(axis, direction), direction)
         .resolve(widthSize)
         .unwrapOrDefault(0.0f);
@@ -365,6 +480,9 @@ class YG_EXPORT Style {
       FlexDirection axis,
       Direction direction,
       float widthSize) const {
+    if (!hasMargin()) {
+      return 0.0f;
+    }
     return computeMargin(flexEndEdge(axis), direction)
         .resolve(widthSize)
         .unwrapOrDefault(0.0f);
@@ -374,12 +492,18 @@ class YG_EXPORT Style {
       FlexDirection axis,
       Direction direction,
       float widthSize) const {
+    if (!hasMargin()) {
+      return 0.0f;
+    }
     return computeMargin(inlineEndEdge(axis, direction), direction)
         .resolve(widthSize)
         .unwrapOrDefault(0.0f);
   }
 
   float computeFlexStartBorder(FlexDirection axis, Direction direction) const {
+    if (!hasBorder()) {
+      return 0.0f;
+    }
     return maxOrDefined(
         computeBorder(flexStartEdge(axis), direction).resolve(0.0f).unwrap(),
         0.0f);
@@ -387,6 +511,9 @@ class YG_EXPORT Style {
 
   float computeInlineStartBorder(FlexDirection axis, Direction direction)
       const {
+    if (!hasBorder()) {
+      return 0.0f;
+    }
     return maxOrDefined(
         computeBorder(inlineStartEdge(axis, direction), direction)
             .resolve(0.0f)
@@ -395,12 +522,18 @@ class YG_EXPORT Style {
   }
 
   float computeFlexEndBorder(FlexDirection axis, Direction direction) const {
+    if (!hasBorder()) {
+      return 0.0f;
+    }
     return maxOrDefined(
         computeBorder(flexEndEdge(axis), direction).resolve(0.0f).unwrap(),
         0.0f);
   }
 
   float computeInlineEndBorder(FlexDirection axis, Direction direction) const {
+    if (!hasBorder()) {
+      return 0.0f;
+    }
     return maxOrDefined(
         computeBorder(inlineEndEdge(axis, direction), direction)
             .resolve(0.0f)
@@ -412,6 +545,9 @@ class YG_EXPORT Style {
       FlexDirection axis,
       Direction direction,
       float widthSize) const {
+    if (!hasPadding()) {
+      return 0.0f;
+    }
     return maxOrDefined(
         computePadding(flexStartEdge(axis), direction)
             .resolve(widthSize)
@@ -423,6 +559,9 @@ class YG_EXPORT Style {
       FlexDirection axis,
       Direction direction,
       float widthSize) const {
+    if (!hasPadding()) {
+      return 0.0f;
+    }
     return maxOrDefined(
         computePadding(inlineStartEdge(axis, direction), direction)
             .resolve(widthSize)
@@ -434,6 +573,9 @@ class YG_EXPORT Style {
       FlexDirection axis,
       Direction direction,
       float widthSize) const {
+    if (!hasPadding()) {
+      return 0.0f;
+    }
     return maxOrDefined(
         computePadding(flexEndEdge(axis), direction)
             .resolve(widthSize)
@@ -445,6 +587,9 @@ class YG_EXPORT Style {
       FlexDirection axis,
       Direction direction,
       float widthSize) const {
+    if (!hasPadding()) {
+      return 0.0f;
+    }
     return maxOrDefined(
         computePadding(inlineEndEdge(axis, direction), direction)
             .resolve(widthSize)
@@ -488,6 +633,9 @@ class YG_EXPORT Style {
       Direction direction,
       Dimension dimension,
       float widthSize) const {
+    if (!hasPadding() && !hasBorder()) {
+      return 0.0f;
+    }
     FlexDirection flexDirectionForDimension = dimension == Dimension::Width
         ? FlexDirection::Row
         : FlexDirection::Column;
@@ -499,11 +647,17 @@ class YG_EXPORT Style {
   }
 
   float computeBorderForAxis(FlexDirection axis) const {
+    if (!hasBorder()) {
+      return 0.0f;
+    }
     return computeInlineStartBorder(axis, Direction::LTR) +
         computeInlineEndBorder(axis, Direction::LTR);
   }
 
   float computeMarginForAxis(FlexDirection axis, float widthSize) const {
+    if (!hasMargin()) {
+      return 0.0f;
+    }
     // The total margin for a given axis does not depend on the direction
     // so hardcoding LTR here to avoid piping direction to this function
     return computeInlineStartMargin(axis, Direction::LTR, widthSize) +
@@ -511,40 +665,67 @@ class YG_EXPORT Style {
   }
 
   float computeGapForAxis(FlexDirection axis, float ownerSize) const {
+    if (!hasGap()) {
+      return 0.0f;
+    }
     auto gap = isRow(axis) ? computeColumnGap() : computeRowGap();
     return maxOrDefined(gap.resolve(ownerSize).unwrap(), 0.0f);
   }
 
   bool flexStartMarginIsAuto(FlexDirection axis, Direction direction) const {
-    return computeMargin(flexStartEdge(axis), direction).isAuto();
+    return hasMargin() &&
+        computeMargin(flexStartEdge(axis), direction).isAuto();
   }
 
   bool flexEndMarginIsAuto(FlexDirection axis, Direction direction) const {
-    return computeMargin(flexEndEdge(axis), direction).isAuto();
+    return hasMargin() && computeMargin(flexEndEdge(axis), direction).isAuto();
+  }
+
+  // Whether any margin edge is set to auto, regardless of direction. Cheaper
+  // than resolving individual edges as it does not read from the pool.
+  bool hasAutoMargin() const {
+    for (const auto& handle : margin_) {
+      if (handle.isAuto()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // The number of 32-bit slots used by values which could not be stored
+  // inline in their handle
+  size_t valuePoolSize() const {
+    return pool_.size();
+  }
+
+  // A hash of the style, maintained as properties are set. Equal styles have
+  // equal fingerprints, so differing fingerprints prove styles differ.
+  uint64_t fingerprint() const {
+    return fingerprint_;
   }
 
   bool operator==(const Style& other) const {
-    return direction_ == other.direction_ &&
+    return fingerprint_ == other.fingerprint_ &&
+        direction_ == other.direction_ &&
         flexDirection_ == other.flexDirection_ &&
         justifyContent_ == other.justifyContent_ &&
         alignContent_ == other.alignContent_ &&
         alignItems_ == other.alignItems_ && alignSelf_ == other.alignSelf_ &&
         positionType_ == other.positionType_ && flexWrap_ == other.flexWrap_ &&
         overflow_ == other.overflow_ && display_ == other.display_ &&
+        boxSizing_ == other.boxSizing_ &&
         numbersEqual(flex_, pool_, other.flex_, other.pool_) &&
         numbersEqual(flexGrow_, pool_, other.flexGrow_, other.pool_) &&
         numbersEqual(flexShrink_, pool_, other.flexShrink_, other.pool_) &&
-        lengthsEqual(flexBasis_, pool_, other.flexBasis_, other.pool_) &&
+        sizesEqual(flexBasis_, pool_, other.flexBasis_, other.pool_) &&
         lengthsEqual(margin_, pool_, other.margin_, other.pool_) &&
         lengthsEqual(position_, pool_, other.position_, other.pool_) &&
         lengthsEqual(padding_, pool_, other.padding_, other.pool_) &&
         lengthsEqual(border_, pool_, other.border_, other.pool_) &&
         lengthsEqual(gap_, pool_, other.gap_, other.pool_) &&
-        lengthsEqual(dimensions_, pool_, other.dimensions_, other.pool_) &&
-        lengthsEqual(
-               minDimensions_, pool_, other.minDimensions_, other.pool_) &&
-        lengthsEqual(
-               maxDimensions_, pool_, other.maxDimensions_, other.pool_) &&
+        sizesEqual(dimensions_, pool_, other.dimensions_, other.pool_) &&
+        sizesEqual(minDimensions_, pool_, other.minDimensions_, other.pool_) &&
+        sizesEqual(maxDimensions_, pool_, other.maxDimensions_, other.pool_) &&
         numbersEqual(aspectRatio_, pool_, other.aspectRatio_, other.pool_);
   }
 
@@ -552,10 +733,43 @@ class YG_EXPORT Style {
     return !(*this == other);
   }
 
+  // Writes a compact, versioned binary encoding of the style into the buffer
+  // when it is large enough, and returns the size of the encoding
+  size_t serialize(uint8_t* buffer, size_t capacity) const;
+
+  // Reads a style written by serialize(). Returns nothing if the encoding is
+  // malformed or of an unsupported version.
+  static std::optional<Style> deserialize(const uint8_t* data, size_t size);
+
  private:
+  // The number of value handles, which serialize() encodes in member order
+  static constexpr size_t kValueHandleCount = 50;
+
+  std::array<const StyleValueHandle*, kValueHandleCount> valueHandles() const;
+
+  // Restores the handle at the given position in valueHandles() from its
+  // packed form, without updating the state derived from it. Returns false if
+  // it does not hold a value the property accepts.
+  bool importValueHandle(
+      size_t index,
+      uint16_t packed,
+      std::span<const uint32_t> values);
+
+  // Brings the resolved edges, property families and fingerprint up to date
+  // with value handles restored into a default style
+  void restoreDerivedState();
+
   using Dimensions = std::array<StyleValueHandle, ordinalCount<Dimension>()>;
   using Edges = std::array<StyleValueHandle, ordinalCount<Edge>()>;
   using Gutters = std::array<StyleValueHandle, ordinalCount<Gutter>()>;
+  // The handles physical edges resolve to. Only left and right depend on the
+  // layout direction, and layout only ever resolves them for LTR or RTL.
+  struct ResolvedEdges {
+    // Left and right for LTR, then left and right for RTL
+    std::array<StyleValueHandle, 4> horizontal{};
+    StyleValueHandle top{};
+    StyleValueHandle bottom{};
+  };
 
   static inline bool numbersEqual(
       const StyleValueHandle& lhsHandle,
@@ -575,6 +789,31 @@ class YG_EXPORT Style {
         (lhsPool.getLength(lhsHandle) == rhsPool.getLength(rhsHandle));
   }
 
+  static inline bool sizesEqual(
+      const StyleValueHandle& lhsHandle,
+      const StyleValuePool& lhsPool,
+      const StyleValueHandle& rhsHandle,
+      const StyleValuePool& rhsPool) {
+    return (lhsHandle.isUndefined() && rhsHandle.isUndefined()) ||
+        (lhsPool.getSize(lhsHandle) == rhsPool.getSize(rhsHandle));
+  }
+
+  template <size_t N>
+  static inline bool sizesEqual(
+      const std::array<StyleValueHandle, N>& lhs,
+      const StyleValuePool& lhsPool,
+      const std::array<StyleValueHandle, N>& rhs,
+      const StyleValuePool& rhsPool) {
+    return std::equal(
+        lhs.begin(),
+        lhs.end(),
+        rhs.begin(),
+        rhs.end(),
+        [&](const auto& lhs, const auto& rhs) {
+          return sizesEqual(lhs, lhsPool, rhs, rhsPool);
+        });
+  }
+
   template <size_t N>
   static inline bool lengthsEqual(
       const std::array<StyleValueHandle, N>& lhs,
@@ -591,6 +830,98 @@ class YG_EXPORT Style {
         });
   }
 
+  // Each property contributes the hash of its value XORed with the hash of
+  // its default value, so the fingerprint of the default style is zero and
+  // does not depend on the order properties were set in.
+  static constexpr uint64_t fingerprintHash(uint32_t slot, uint64_t bits) {
+    uint64_t hash = bits + 0x9e3779b97f4a7c15ull * (slot + 1);
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+    return hash ^ (hash >> 31);
+  }
+
+  static uint64_t fingerprintBits(float value) {
+    if (yoga::isUndefined(value)) {
+      return 0x7fc00000u;
+    }
+    // 0 and -0 compare equal
+    return value == 0.0f ? 0 : std::bit_cast<uint32_t>(value);
+  }
+
+  static uint64_t fingerprintBits(FloatOptional value) {
+    return fingerprintBits(value.unwrap());
+  }
+
+  template <typename LengthT>
+    requires std::is_same_v<LengthT, Style::Length> ||
+      std::is_same_v<LengthT, Style::SizeLength>
+  static uint64_t fingerprintBits(LengthT value) {
+    const auto ygValue = static_cast<YGValue>(value);
+    return (static_cast<uint64_t>(ygValue.unit) << 32) |
+        fingerprintBits(ygValue.value);
+  }
+
+  template <typename EnumT>
+    requires std::is_enum_v<EnumT>
+  static uint64_t fingerprintBits(EnumT value) {
+    return static_cast<uint64_t>(value);
+  }
+
+  template <typename ValueT>
+  void updateFingerprint(
+      StyleProperty property,
+      ValueT oldValue,
+      ValueT newValue) {
+    const auto slot = static_cast<uint32_t>(property) << 8;
+    fingerprint_ ^= fingerprintHash(slot, fingerprintBits(oldValue)) ^
+        fingerprintHash(slot, fingerprintBits(newValue));
+  }
+
+  template <typename IndexT, typename ValueT>
+  void updateFingerprint(
+      StyleProperty property,
+      IndexT index,
+      ValueT oldValue,
+      ValueT newValue) {
+    const auto slot = (static_cast<uint32_t>(property) << 8) |
+        static_cast<uint32_t>(yoga::to_underlying(index));
+    fingerprint_ ^= fingerprintHash(slot, fingerprintBits(oldValue)) ^
+        fingerprintHash(slot, fingerprintBits(newValue));
+  }
+
+  enum class Feature : uint8_t {
+    Margin = 1 << 0,
+    Position = 1 << 1,
+    Padding = 1 << 2,
+    Border = 1 << 3,
+    Gap = 1 << 4,
+    MinDimension = 1 << 5,
+    MaxDimension = 1 << 6,
+    AspectRatio = 1 << 7,
+  };
+
+  bool hasFeature(Feature feature) const {
+    return (features_ & yoga::to_underlying(feature)) != 0;
+  }
+
+  void updateFeature(Feature feature, bool isSet) {
+    if (isSet) {
+      features_ |= yoga::to_underlying(feature);
+    } else {
+      features_ &= static_cast<uint8_t>(~yoga::to_underlying(feature));
+    }
+  }
+
+  template <size_t N>
+  static bool anyDefined(const std::array<StyleValueHandle, N>& handles) {
+    for (const auto& handle : handles) {
+      if (handle.isDefined()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   Style::Length computeColumnGap() const {
     if (gap_[yoga::to_underlying(Gutter::Column)].isDefined()) {
       return pool_.getLength(gap_[yoga::to_underlying(Gutter::Column)]);
@@ -607,120 +938,115 @@ class YG_EXPORT Style {
     }
   }
 
-  Style::Length computeLeftEdge(const Edges& edges, Direction layoutDirection)
-      const {
+  static const StyleValueHandle& leftEdge(
+      const Edges& edges,
+      Direction layoutDirection) {
     if (layoutDirection == Direction::LTR &&
         edges[yoga::to_underlying(Edge::Start)].isDefined()) {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::Start)]);
+      return edges[yoga::to_underlying(Edge::Start)];
     } else if (
         layoutDirection == Direction::RTL &&
         edges[yoga::to_underlying(Edge::End)].isDefined()) {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::End)]);
+      return edges[yoga::to_underlying(Edge::End)];
     } else if (edges[yoga::to_underlying(Edge::Left)].isDefined()) {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::Left)]);
+      return edges[yoga::to_underlying(Edge::Left)];
     } else if (edges[yoga::to_underlying(Edge::Horizontal)].isDefined()) {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::Horizontal)]);
+      return edges[yoga::to_underlying(Edge::Horizontal)];
     } else {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::All)]);
+      return edges[yoga::to_underlying(Edge::All)];
     }
   }
 
-  Style::Length computeTopEdge(const Edges& edges) const {
+  static const StyleValueHandle& topEdge(const Edges& edges) {
     if (edges[yoga::to_underlying(Edge::Top)].isDefined()) {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::Top)]);
+      return edges[yoga::to_underlying(Edge::Top)];
     } else if (edges[yoga::to_underlying(Edge::Vertical)].isDefined()) {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::Vertical)]);
+      return edges[yoga::to_underlying(Edge::Vertical)];
     } else {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::All)]);
+      return edges[yoga::to_underlying(Edge::All)];
     }
   }
 
-  Style::Length computeRightEdge(const Edges& edges, Direction layoutDirection)
-      const {
+  static const StyleValueHandle& rightEdge(
+      const Edges& edges,
+      Direction layoutDirection) {
     if (layoutDirection == Direction::LTR &&
         edges[yoga::to_underlying(Edge::End)].isDefined()) {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::End)]);
+      return edges[yoga::to_underlying(Edge::End)];
     } else if (
         layoutDirection == Direction::RTL &&
         edges[yoga::to_underlying(Edge::Start)].isDefined()) {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::Start)]);
+      return edges[yoga::to_underlying(Edge::Start)];
     } else if (edges[yoga::to_underlying(Edge::Right)].isDefined()) {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::Right)]);
+      return edges[yoga::to_underlying(Edge::Right)];
     } else if (edges[yoga::to_underlying(Edge::Horizontal)].isDefined()) {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::Horizontal)]);
+      return edges[yoga::to_underlying(Edge::Horizontal)];
     } else {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::All)]);
+      return edges[yoga::to_underlying(Edge::All)];
     }
   }
 
-  Style::Length computeBottomEdge(const Edges& edges) const {
+  static const StyleValueHandle& bottomEdge(const Edges& edges) {
     if (edges[yoga::to_underlying(Edge::Bottom)].isDefined()) {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::Bottom)]);
+      return edges[yoga::to_underlying(Edge::Bottom)];
     } else if (edges[yoga::to_underlying(Edge::Vertical)].isDefined()) {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::Vertical)]);
+      return edges[yoga::to_underlying(Edge::Vertical)];
     } else {
-      return pool_.getLength(edges[yoga::to_underlying(Edge::All)]);
+      return edges[yoga::to_underlying(Edge::All)];
     }
   }
 
-  Style::Length computePosition(PhysicalEdge edge, Direction direction) const {
+  // Resolves the fallback chain of every physical edge for LTR and RTL layout
+  // up front. Setters call this after changing any edge, so the table only
+  // holds copies of handles which are still in use.
+  static void resolveEdges(const Edges& edges, ResolvedEdges& resolved) {
+    resolved.horizontal = {
+        leftEdge(edges, Direction::LTR),
+        rightEdge(edges, Direction::LTR),
+        leftEdge(edges, Direction::RTL),
+        rightEdge(edges, Direction::RTL)};
+    resolved.top = topEdge(edges);
+    resolved.bottom = bottomEdge(edges);
+  }
+
+  Style::Length resolvedEdge(
+      const Edges& edges,
+      const ResolvedEdges& resolved,
+      PhysicalEdge edge,
+      Direction direction) const {
     switch (edge) {
-      case PhysicalEdge::Left:
-        return computeLeftEdge(position_, direction);
       case PhysicalEdge::Top:
-        return computeTopEdge(position_);
-      case PhysicalEdge::Right:
-        return computeRightEdge(position_, direction);
+        return pool_.getLength(resolved.top);
       case PhysicalEdge::Bottom:
-        return computeBottomEdge(position_);
+        return pool_.getLength(resolved.bottom);
+      case PhysicalEdge::Left:
+      case PhysicalEdge::Right:
+        break;
     }
+    if (direction == Direction::Inherit) [[unlikely]] {
+      return pool_.getLength(
+          edge == PhysicalEdge::Left ? leftEdge(edges, direction)
+                                     : rightEdge(edges, direction));
+    }
+    const size_t index = (direction == Direction::RTL ? 2 : 0) +
+        (edge == PhysicalEdge::Right ? 1 : 0);
+    return pool_.getLength(resolved.horizontal[index]);
+  }
 
-    fatalWithMessage("Invalid physical edge");
+  Style::Length computePosition(PhysicalEdge edge, Direction direction) const {
+    return resolvedEdge(position_, resolvedPosition_, edge, direction);
   }
 
   Style::Length computeMargin(PhysicalEdge edge, Direction direction) const {
-    switch (edge) {
-      case PhysicalEdge::Left:
-        return computeLeftEdge(margin_, direction);
-      case PhysicalEdge::Top:
-        return computeTopEdge(margin_);
-      case PhysicalEdge::Right:
-        return computeRightEdge(margin_, direction);
-      case PhysicalEdge::Bottom:
-        return computeBottomEdge(margin_);
-    }
-
-    fatalWithMessage("Invalid physical edge");
+    return resolvedEdge(margin_, resolvedMargin_, edge, direction);
   }
 
   Style::Length computePadding(PhysicalEdge edge, Direction direction) const {
-    switch (edge) {
-      case PhysicalEdge::Left:
-        return computeLeftEdge(padding_, direction);
-      case PhysicalEdge::Top:
-        return computeTopEdge(padding_);
-      case PhysicalEdge::Right:
-        return computeRightEdge(padding_, direction);
-      case PhysicalEdge::Bottom:
-        return computeBottomEdge(padding_);
-    }
-
-    fatalWithMessage("Invalid physical edge");
+    return resolvedEdge(padding_, resolvedPadding_, edge, direction);
   }
 
   Style::Length computeBorder(PhysicalEdge edge, Direction direction) const {
-    switch (edge) {
-      case PhysicalEdge::Left:
-        return computeLeftEdge(border_, direction);
-      case PhysicalEdge::Top:
-        return computeTopEdge(border_);
-      case PhysicalEdge::Right:
-        return computeRightEdge(border_, direction);
-      case PhysicalEdge::Bottom:
-        return computeBottomEdge(border_);
-    }
-
-    fatalWithMessage("Invalid physical edge");
+    return resolvedEdge(border_, resolvedBorder_, edge, direction);
   }
 
   Direction direction_ : bitCount<Direction>() = Direction::Inherit;
@@ -745,6 +1071,10 @@ class YG_EXPORT Style {
   Edges position_{};
   Edges padding_{};
   Edges border_{};
+  ResolvedEdges resolvedMargin_{};
+  ResolvedEdges resolvedPosition_{};
+  ResolvedEdges resolvedPadding_{};
+  ResolvedEdges resolvedBorder_{};
   Gutters gap_{};
   Dimensions dimensions_{
       StyleValueHandle::ofAuto(),
@@ -754,6 +1084,8 @@ class YG_EXPORT Style {
   StyleValueHandle aspectRatio_{};
 
   StyleValuePool pool_;
+  uint64_t fingerprint_ = 0;
+  uint8_t features_ = 0;
 };
 
 } // namespace facebook::yoga
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include <yoga/Yoga.h>
+
+#include <yoga/style/Style.h>
+
+// Tag struct used to form the opaque YGStyleTemplateRef for the public C API
+struct YGStyleTemplate {};
+
+namespace facebook::yoga {
+
+// A style built once and shared by every node it is attached to. The style is
+// never changed after the template is built, so nodes attached to it give
+// themselves their own copy before changing their style.
+class YG_EXPORT StyleTemplate : public ::YGStyleTemplate {
+ public:
+  explicit StyleTemplate(Style style)
+      : style_{std::make_shared<Style>(std::move(style))} {}
+
+  const std::shared_ptr<Style>& style() const {
+    return style_;
+  }
+
+ private:
+  std::shared_ptr<Style> style_;
+};
+
+inline StyleTemplate* resolveRef(const YGStyleTemplateRef ref) {
+  return static_cast<StyleTemplate*>(ref);
+}
+
+inline const StyleTemplate* resolveRef(const YGStyleTemplateConstRef ref) {
+  return static_cast<const StyleTemplate*>(ref);
+}
+
+} // namespace facebook::yoga
@@ -49,6 +49,8 @@ class StyleValueHandle {
     return type() == Type::Auto;
   }
 
+  constexpr bool operator==(const StyleValueHandle& other) const = default;
+
  private:
   friend class StyleValuePool;
 
@@ -98,6 +100,10 @@ class StyleValueHandle {
     repr_ |= kHandleIndexedMask;
   }
 
+  constexpr void setValueIsInline() {
+    repr_ &= ~kHandleIndexedMask;
+  }
+
   uint16_t repr_{0};
 };
 
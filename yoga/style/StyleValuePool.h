@@ -7,8 +7,11 @@
 
 #pragma once
 
+#include <bit>
 #include <cassert>
 #include <cstdint>
+#include <optional>
+#include <span>
 
 #include <yoga/numeric/FloatOptional.h>
 #include <yoga/style/SmallValueBuffer.h>
@@ -24,14 +27,15 @@ namespace facebook::yoga {
  * cases StyleValueHandle can embed the value directly, but if not, the value is
  * stored within a buffer provided by the pool. The pool contains a fixed number
  * of inline slots before falling back to heap allocating additional slots.
+ * A slot is released as soon as its handle no longer needs it, for later reuse.
  */
 class StyleValuePool {
  public:
   void store(StyleValueHandle& handle, StyleLength length) {
     if (length.isUndefined()) {
-      handle.setType(StyleValueHandle::Type::Undefined);
+      storeType(handle, StyleValueHandle::Type::Undefined);
     } else if (length.isAuto()) {
-      handle.setType(StyleValueHandle::Type::Auto);
+      storeType(handle, StyleValueHandle::Type::Auto);
     } else {
       auto type = length.isPoints() ? StyleValueHandle::Type::Point
                                     : StyleValueHandle::Type::Percent;
@@ -41,9 +45,9 @@ class StyleValuePool {
 
   void store(StyleValueHandle& handle, StyleSizeLength sizeValue) {
     if (sizeValue.isUndefined()) {
-      handle.setType(StyleValueHandle::Type::Undefined);
+      storeType(handle, StyleValueHandle::Type::Undefined);
     } else if (sizeValue.isAuto()) {
-      handle.setType(StyleValueHandle::Type::Auto);
+      storeType(handle, StyleValueHandle::Type::Auto);
     } else if (sizeValue.isMaxContent()) {
       storeKeyword(handle, StyleValueHandle::Keyword::MaxContent);
     } else if (sizeValue.isStretch()) {
@@ -59,7 +63,7 @@ class StyleValuePool {
 
   void store(StyleValueHandle& handle, FloatOptional number) {
     if (number.isUndefined()) {
-      handle.setType(StyleValueHandle::Type::Undefined);
+      storeType(handle, StyleValueHandle::Type::Undefined);
     } else {
       storeValue(handle, number.unwrap(), StyleValueHandle::Type::Number);
     }
@@ -121,19 +125,122 @@ class StyleValuePool {
     }
   }
 
+  // The number of 32-bit slots spanned by values stored in the pool
+  size_t size() const {
+    return buffer_.size();
+  }
+
+  // Packs a handle the way it is stored, independently of the pool. A value
+  // stored in the pool is appended to `values`, and the packed handle refers
+  // to its position there instead.
+  uint16_t exportHandle(
+      StyleValueHandle handle,
+      uint32_t* values,
+      size_t& valueCount) const {
+    if (handle.isValueIndexed()) {
+      values[valueCount] = buffer_.get32(handle.value());
+      handle.setValue(static_cast<uint16_t>(valueCount++));
+    }
+    return handle.repr_;
+  }
+
+  // Unpack handles packed by exportHandle(). These return nothing if the
+  // packed handle does not hold a value of the requested kind.
+  static std::optional<StyleLength> importLength(
+      uint16_t packed,
+      std::span<const uint32_t> values) {
+    const auto handle = fromPacked(packed);
+    switch (handle.type()) {
+      case StyleValueHandle::Type::Undefined:
+        return StyleLength::undefined();
+      case StyleValueHandle::Type::Auto:
+        return StyleLength::ofAuto();
+      case StyleValueHandle::Type::Point:
+      case StyleValueHandle::Type::Percent: {
+        const auto value = importValue(handle, values);
+        if (!value.has_value()) {
+          return std::nullopt;
+        }
+        return handle.type() == StyleValueHandle::Type::Point
+            ? StyleLength::points(*value)
+            : StyleLength::percent(*value);
+      }
+      default:
+        return std::nullopt;
+    }
+  }
+
+  static std::optional<StyleSizeLength> importSize(
+      uint16_t packed,
+      std::span<const uint32_t> values) {
+    const auto handle = fromPacked(packed);
+    switch (handle.type()) {
+      case StyleValueHandle::Type::Undefined:
+        return StyleSizeLength::undefined();
+      case StyleValueHandle::Type::Auto:
+        return StyleSizeLength::ofAuto();
+      case StyleValueHandle::Type::Keyword:
+        if (handle.isKeyword(StyleValueHandle::Keyword::MaxContent)) {
+          return StyleSizeLength::ofMaxContent();
+        } else if (handle.isKeyword(StyleValueHandle::Keyword::FitContent)) {
+          return StyleSizeLength::ofFitContent();
+        } else if (handle.isKeyword(StyleValueHandle::Keyword::Stretch)) {
+          return StyleSizeLength::ofStretch();
+        }
+        return std::nullopt;
+      case StyleValueHandle::Type::Point:
+      case StyleValueHandle::Type::Percent: {
+        const auto value = importValue(handle, values);
+        if (!value.has_value()) {
+          return std::nullopt;
+        }
+        return handle.type() == StyleValueHandle::Type::Point
+            ? StyleSizeLength::points(*value)
+            : StyleSizeLength::percent(*value);
+      }
+      default:
+        return std::nullopt;
+    }
+  }
+
+  static std::optional<FloatOptional> importNumber(
+      uint16_t packed,
+      std::span<const uint32_t> values) {
+    const auto handle = fromPacked(packed);
+    switch (handle.type()) {
+      case StyleValueHandle::Type::Undefined:
+        return FloatOptional{};
+      case StyleValueHandle::Type::Number: {
+        const auto value = importValue(handle, values);
+        if (!value.has_value()) {
+          return std::nullopt;
+        }
+        return FloatOptional{*value};
+      }
+      default:
+        return std::nullopt;
+    }
+  }
+
  private:
+  void storeType(StyleValueHandle& handle, StyleValueHandle::Type type) {
+    release(handle);
+    handle.setType(type);
+  }
+
   void storeValue(
       StyleValueHandle& handle,
       float value,
       StyleValueHandle::Type type) {
     handle.setType(type);
 
-    if (handle.isValueIndexed()) {
+    if (isIntegerPackable(value)) {
+      release(handle);
+      handle.setValue(packInlineInteger(value));
+    } else if (handle.isValueIndexed()) {
       auto newIndex =
           buffer_.replace(handle.value(), std::bit_cast<uint32_t>(value));
       handle.setValue(newIndex);
-    } else if (isIntegerPackable(value)) {
-      handle.setValue(packInlineInteger(value));
     } else {
       auto newIndex = buffer_.push(std::bit_cast<uint32_t>(value));
       handle.setValue(newIndex);
@@ -144,14 +251,35 @@ class StyleValuePool {
   void storeKeyword(
       StyleValueHandle& handle,
       StyleValueHandle::Keyword keyword) {
+    release(handle);
     handle.setType(StyleValueHandle::Type::Keyword);
+    handle.setValue(static_cast<uint16_t>(keyword));
+  }
+
+  static StyleValueHandle fromPacked(uint16_t packed) {
+    StyleValueHandle handle;
+    handle.repr_ = packed;
+    return handle;
+  }
 
+  static std::optional<float> importValue(
+      StyleValueHandle handle,
+      std::span<const uint32_t> values) {
+    if (!handle.isValueIndexed()) {
+      return unpackInlineInteger(handle.value());
+    }
+    if (handle.value() >= values.size()) {
+      return std::nullopt;
+    }
+    return std::bit_cast<float>(values[handle.value()]);
+  }
+
+  // Gives back the slot of a handle with an indexed value to the buffer
+  void release(StyleValueHandle& handle) {
     if (handle.isValueIndexed()) {
-      auto newIndex =
-          buffer_.replace(handle.value(), static_cast<uint32_t>(keyword));
-      handle.setValue(newIndex);
-    } else {
-      handle.setValue(static_cast<uint16_t>(keyword));
+      buffer_.free(handle.value());
+      handle.setValue(0);
+      handle.setValueIsInline();
     }
   }
 